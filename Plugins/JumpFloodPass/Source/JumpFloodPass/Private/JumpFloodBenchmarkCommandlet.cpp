@@ -0,0 +1,477 @@
+// Copyright James Maiden. All Rights Reserved.
+#include "JumpFloodBenchmarkCommandlet.h"
+#include "JumpFloodCPU.h"
+
+#include "Algo/BinarySearch.h"
+#include "Async/ParallelFor.h"
+#include "HAL/PlatformTime.h"
+#include "Math/RandomStream.h"
+#include "Misc/DateTime.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogJumpFloodBenchmark, Log, All);
+
+//  Squared distance given to texels that have no seed at all
+static constexpr int64 JumpFloodBenchmarkNoSeed = INDEX_NONE;
+
+struct FJumpFloodBenchmarkMask
+{
+	const TCHAR* Name;
+	void (*Generate)(const FIntPoint& Size, FRandomStream& Random, TArray<uint8>& OutStencil);
+};
+
+struct FJumpFloodBenchmarkSchedule
+{
+	const TCHAR* Name;
+	FJumpFloodCPUSettings Settings;
+};
+
+struct FJumpFloodBenchmarkResult
+{
+	double Milliseconds = 0.0;
+	float ErrorRate = 0.0f;
+	float MaxError = 0.0f;
+	float MeanError = 0.0f;
+	int64 MissedCount = 0;
+
+	/** Texels beyond a bounded flood's radius that kept a seed outside the stencil, or weren't held at -MaxDistance inside it */
+	int64 ClampErrorCount = 0;
+
+	/** Texels whose resolved stencil isn't the one at their seed, or that resolved a depth without being given any */
+	int64 PayloadErrorCount = 0;
+};
+
+static void GenerateCircles(const FIntPoint& Size, FRandomStream& Random, TArray<uint8>& OutStencil)
+{
+	const int32 LargestSide = FMath::Max(Size.X, Size.Y);
+	for (int32 CircleIndex = 0; CircleIndex < 12; ++CircleIndex)
+	{
+		const FVector2f Center = FVector2f(Random.FRandRange(0.0f, Size.X), Random.FRandRange(0.0f, Size.Y));
+		const float Radius = Random.FRandRange(LargestSide / 32.0f, LargestSide / 6.0f);
+
+		for (int32 Y = FMath::Max(0, (int32) (Center.Y - Radius)); Y < FMath::Min(Size.Y, (int32) (Center.Y + Radius) + 1); ++Y)
+		{
+			for (int32 X = FMath::Max(0, (int32) (Center.X - Radius)); X < FMath::Min(Size.X, (int32) (Center.X + Radius) + 1); ++X)
+			{
+				if (FVector2f::DistSquared(FVector2f(X + 0.5f, Y + 0.5f), Center) <= Radius * Radius)
+				{
+					OutStencil[Y * Size.X + X] = 1;
+				}
+			}
+		}
+	}
+}
+
+static void GenerateThinLines(const FIntPoint& Size, FRandomStream& Random, TArray<uint8>& OutStencil)
+{
+	for (int32 LineIndex = 0; LineIndex < 16; ++LineIndex)
+	{
+		const FVector2f Start = FVector2f(Random.FRandRange(0.0f, Size.X - 1), Random.FRandRange(0.0f, Size.Y - 1));
+		const FVector2f End = FVector2f(Random.FRandRange(0.0f, Size.X - 1), Random.FRandRange(0.0f, Size.Y - 1));
+		const int32 PointCount = FMath::CeilToInt(FVector2f::Distance(Start, End)) + 1;
+
+		for (int32 PointIndex = 0; PointIndex <= PointCount; ++PointIndex)
+		{
+			const FVector2f Point = FMath::Lerp(Start, End, (float) PointIndex / PointCount);
+			OutStencil[(int32) Point.Y * Size.X + (int32) Point.X] = 1;
+		}
+	}
+}
+
+static void GenerateNoise(const FIntPoint& Size, FRandomStream& Random, TArray<uint8>& OutStencil)
+{
+	//  Blocks of a few texels, so that most of the mask is edge
+	static constexpr int32 CellSize = 4;
+
+	const int32 CellCountX = FMath::DivideAndRoundUp(Size.X, CellSize);
+	const int32 CellCountY = FMath::DivideAndRoundUp(Size.Y, CellSize);
+
+	for (int32 CellY = 0; CellY < CellCountY; ++CellY)
+	{
+		for (int32 CellX = 0; CellX < CellCountX; ++CellX)
+		{
+			if (Random.FRand() >= 0.5f)
+			{
+				continue;
+			}
+
+			for (int32 Y = CellY * CellSize; Y < FMath::Min(Size.Y, (CellY + 1) * CellSize); ++Y)
+			{
+				for (int32 X = CellX * CellSize; X < FMath::Min(Size.X, (CellX + 1) * CellSize); ++X)
+				{
+					OutStencil[Y * Size.X + X] = 1;
+				}
+			}
+		}
+	}
+}
+
+static void GenerateManySeeds(const FIntPoint& Size, FRandomStream& Random, TArray<uint8>& OutStencil)
+{
+	const int32 SeedCount = FMath::Max(Size.X * Size.Y / 256, 1);
+	for (int32 SeedIndex = 0; SeedIndex < SeedCount; ++SeedIndex)
+	{
+		OutStencil[Random.RandHelper(Size.Y) * Size.X + Random.RandHelper(Size.X)] = 1;
+	}
+}
+
+//  Exact distance to the nearest seed by search, sharing nothing with either flood. Seeds are bucketed by row and rows are
+//  searched outwards until no closer seed can be found
+static void FindReferenceDistances(const FIntPoint& Size, TConstArrayView<uint32> Seeds, TArray<int64>& OutDistancesSquared)
+{
+	TArray<TArray<int32>> RowSeedXs;
+	RowSeedXs.SetNum(Size.Y);
+
+	for (int32 Y = 0; Y < Size.Y; ++Y)
+	{
+		for (int32 X = 0; X < Size.X; ++X)
+		{
+			if (Seeds[Y * Size.X + X] != 0)
+			{
+				RowSeedXs[Y].Add(X);
+			}
+		}
+	}
+
+	OutDistancesSquared.SetNumUninitialized(Seeds.Num());
+
+	ParallelFor(Size.Y, [&Size, &RowSeedXs, &OutDistancesSquared](int32 Y)
+	{
+		for (int32 X = 0; X < Size.X; ++X)
+		{
+			int64 BestDistanceSquared = MAX_int64;
+
+			for (int32 DeltaY = 0; (int64) DeltaY * DeltaY < BestDistanceSquared && (Y - DeltaY >= 0 || Y + DeltaY < Size.Y); ++DeltaY)
+			{
+				for (int32 Side = 0; Side < (DeltaY == 0 ? 1 : 2); ++Side)
+				{
+					const int32 SampleY = Side == 0 ? Y - DeltaY : Y + DeltaY;
+					if (SampleY < 0 || SampleY >= Size.Y)
+					{
+						continue;
+					}
+
+					const TArray<int32>& SeedXs = RowSeedXs[SampleY];
+					const int32 Index = Algo::LowerBound(SeedXs, X);
+
+					for (const int32 Candidate : { Index - 1, Index })
+					{
+						if (SeedXs.IsValidIndex(Candidate))
+						{
+							const int64 DeltaX = SeedXs[Candidate] - X;
+							BestDistanceSquared = FMath::Min(BestDistanceSquared, DeltaX * DeltaX + (int64) DeltaY * DeltaY);
+						}
+					}
+				}
+			}
+
+			OutDistancesSquared[Y * Size.X + X] = BestDistanceSquared != MAX_int64 ? BestDistanceSquared : JumpFloodBenchmarkNoSeed;
+		}
+	});
+}
+
+static FJumpFloodBenchmarkResult RunSchedule(
+	const FIntPoint& Size,
+	TConstArrayView<uint8> Stencil,
+	TConstArrayView<int64> ReferenceDistancesSquared,
+	const FJumpFloodCPUSettings& Settings,
+	int32 IterationCount)
+{
+	FJumpFloodBenchmarkResult Result;
+
+	TArray<uint32> Seeds;
+	TArray<FVector4f> Primary;
+	TArray<FVector4f> Secondary;
+	Seeds.SetNumUninitialized(Stencil.Num());
+	Primary.SetNumUninitialized(Stencil.Num());
+	Secondary.SetNumUninitialized(Stencil.Num());
+
+	//  Seed, flood and resolve, the same work the GPU's SeedPS, FloodPS and CopyPS do on packed seeds. The float path, which
+	//  floods seed UVs in the primary target's format when packed seeds are off, rounds differently and is not covered here
+	for (int32 Iteration = 0; Iteration < IterationCount; ++Iteration)
+	{
+		const double StartTime = FPlatformTime::Seconds();
+
+		FJumpFloodCPU::Seed(Size, Stencil, Seeds);
+		if (Settings.Method == EJumpFloodCPUMethod::ExactEDT)
+		{
+			FJumpFloodCPU::FloodExact(Size, Seeds);
+		}
+		else
+		{
+			FJumpFloodCPU::Flood(Size, Seeds, Settings);
+		}
+		FJumpFloodCPU::Resolve(Size, Seeds, Stencil, {}, Settings.MaxDistance, Primary, Secondary);
+
+		Result.Milliseconds += (FPlatformTime::Seconds() - StartTime) * 1000.0 / IterationCount;
+	}
+
+	int64 ComparedCount = 0;
+	int64 ErrorCount = 0;
+	double ErrorSum = 0.0;
+
+	//  Measured on the resolved field, as CopyPS writes it, so the sign, the clamp and the payload are checked along with the flood
+	for (int32 Index = 0; Index < Seeds.Num(); ++Index)
+	{
+		const int64 ReferenceDistanceSquared = ReferenceDistancesSquared[Index];
+		if (ReferenceDistanceSquared == JumpFloodBenchmarkNoSeed)
+		{
+			continue;
+		}
+
+		const FVector4f& Resolved = Primary[Index];
+		const bool bInside = Stencil[Index] > 0;
+		const float ReferenceDistance = FMath::Sqrt((float) ReferenceDistanceSquared);
+
+		//  A bounded flood only has to be right within its radius. Beyond it, outside the stencil has no seed and inside is held
+		//  at -MaxDistance, or has no seed when the flood didn't reach that far in
+		if (Settings.MaxDistance > 0.0f && ReferenceDistance > Settings.MaxDistance)
+		{
+			if (Resolved.W != 0.0f && (!bInside || Resolved.Z != -Settings.MaxDistance))
+			{
+				++Result.ClampErrorCount;
+			}
+			continue;
+		}
+
+		++ComparedCount;
+
+		if (Resolved.W == 0.0f)
+		{
+			++Result.MissedCount;
+			++ErrorCount;
+			continue;
+		}
+
+		const FIntPoint SeedPosition = FJumpFloodCPU::UnpackSeed(Seeds[Index]);
+		const FVector4f& Payload = Secondary[Index];
+		if (Payload.X != Stencil[SeedPosition.Y * Size.X + SeedPosition.X] || Payload.Y != 0.0f)
+		{
+			++Result.PayloadErrorCount;
+		}
+
+		//  Both take the same float square root of a whole squared distance, so a texel that found its nearest seed matches exactly
+		const float SignedReferenceDistance = bInside ? -ReferenceDistance : ReferenceDistance;
+		if (Resolved.Z != SignedReferenceDistance)
+		{
+			const float Error = FMath::Abs(Resolved.Z - SignedReferenceDistance);
+
+			++ErrorCount;
+			ErrorSum += Error;
+			Result.MaxError = FMath::Max(Result.MaxError, Error);
+		}
+	}
+
+	Result.ErrorRate = ComparedCount > 0 ? (float) ErrorCount / ComparedCount : 0.0f;
+	Result.MeanError = ErrorCount > Result.MissedCount ? (float) (ErrorSum / (ErrorCount - Result.MissedCount)) : 0.0f;
+	return Result;
+}
+
+static const FJumpFloodBenchmarkMask JumpFloodBenchmarkMasks[] = {
+	{ TEXT("Circles"), &GenerateCircles },
+	{ TEXT("ThinLines"), &GenerateThinLines },
+	{ TEXT("Noise"), &GenerateNoise },
+	{ TEXT("ManySeeds"), &GenerateManySeeds },
+};
+
+//  JFA comes first, as the baseline the other schedules are held to
+static TArray<FJumpFloodBenchmarkSchedule> GetSchedules(float BoundedDistance)
+{
+	TArray<FJumpFloodBenchmarkSchedule> Schedules;
+	Schedules.Add({ TEXT("JFA"), { EJumpFloodCPUMethod::JumpFlood, 0.0f, 0, 0 } });
+	Schedules.Add({ TEXT("1+JFA"), { EJumpFloodCPUMethod::JumpFlood, 0.0f, 1, 0 } });
+	Schedules.Add({ TEXT("JFA+1"), { EJumpFloodCPUMethod::JumpFlood, 0.0f, 0, 1 } });
+	Schedules.Add({ TEXT("JFA+2"), { EJumpFloodCPUMethod::JumpFlood, 0.0f, 0, 2 } });
+	Schedules.Add({ TEXT("1+JFA Bounded"), { EJumpFloodCPUMethod::JumpFlood, BoundedDistance, 1, 0 } });
+	Schedules.Add({ TEXT("ExactEDT"), { EJumpFloodCPUMethod::ExactEDT, 0.0f, 0, 0 } });
+	return Schedules;
+}
+
+//  Generates a mask, seeded by resolution so every run floods the same masks, along with its reference distances
+static void GenerateMask(const FJumpFloodBenchmarkMask& Mask, const FIntPoint& Size, TArray<uint8>& OutStencil, TArray<int64>& OutReferenceDistancesSquared)
+{
+	FRandomStream Random(Size.X);
+
+	OutStencil.Reset();
+	OutStencil.SetNumZeroed(Size.X * Size.Y);
+	Mask.Generate(Size, Random, OutStencil);
+
+	TArray<uint32> ReferenceSeeds;
+	ReferenceSeeds.SetNumUninitialized(OutStencil.Num());
+	FJumpFloodCPU::Seed(Size, OutStencil, ReferenceSeeds);
+
+	FindReferenceDistances(Size, ReferenceSeeds, OutReferenceDistancesSquared);
+}
+
+//  Why a schedule's result fails its gates, or empty when it passes. The exact transform must be exact, 1+JFA, as the GPU runs
+//  it, must stay within AllowedErrorRate, and every schedule must clamp and carry its payload as CopyPS does
+static FString GetScheduleFailure(const FJumpFloodBenchmarkSchedule& Schedule, const FJumpFloodBenchmarkResult& Result, float AllowedErrorRate)
+{
+	const bool bExact = Schedule.Settings.Method == EJumpFloodCPUMethod::ExactEDT;
+	const bool bGPUSchedule = !bExact && Schedule.Settings.MaxDistance <= 0.0f && Schedule.Settings.LeadingUnitStepCount == 1 && Schedule.Settings.TrailingStepCount == 0;
+
+	if (bExact && Result.ErrorRate > 0.0f)
+	{
+		return FString::Printf(TEXT("has an error rate of %f, over 0"), Result.ErrorRate);
+	}
+
+	if (bGPUSchedule && Result.ErrorRate > AllowedErrorRate)
+	{
+		return FString::Printf(TEXT("has an error rate of %f, over %f"), Result.ErrorRate, AllowedErrorRate);
+	}
+
+	if (Result.ClampErrorCount > 0)
+	{
+		return FString::Printf(TEXT("has %lld texels beyond MaxDistance that weren't clamped"), Result.ClampErrorCount);
+	}
+
+	if (Result.PayloadErrorCount > 0)
+	{
+		return FString::Printf(TEXT("has %lld texels with the wrong payload"), Result.PayloadErrorCount);
+	}
+
+	return FString();
+}
+
+UJumpFloodBenchmarkCommandlet::UJumpFloodBenchmarkCommandlet()
+{
+	IsClient = false;
+	IsEditor = false;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UJumpFloodBenchmarkCommandlet::Main(const FString& Params)
+{
+	FString ResolutionList = TEXT("256+512+1024+8192");
+	FParse::Value(*Params, TEXT("Resolutions="), ResolutionList);
+
+	TArray<FString> ResolutionNames;
+	ResolutionList.ParseIntoArray(ResolutionNames, TEXT("+"));
+
+	int32 IterationCount = 3;
+	FParse::Value(*Params, TEXT("Iterations="), IterationCount);
+	IterationCount = FMath::Max(IterationCount, 1);
+
+	float BoundedDistance = 32.0f;
+	FParse::Value(*Params, TEXT("BoundedDistance="), BoundedDistance);
+
+	//  By default 1+JFA must do no worse than plain JFA on the same mask, give or take a little noise
+	float ErrorRateEpsilon = 0.001f;
+	FParse::Value(*Params, TEXT("ErrorRateEpsilon="), ErrorRateEpsilon);
+
+	float MaxErrorRate = -1.0f;
+	const bool bFixedMaxErrorRate = FParse::Value(*Params, TEXT("MaxErrorRate="), MaxErrorRate);
+
+	FString CsvPath = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("JumpFlood"), FString::Printf(TEXT("Benchmark-%s.csv"), *FDateTime::Now().ToString()));
+	FParse::Value(*Params, TEXT("Csv="), CsvPath);
+
+	const TArray<FJumpFloodBenchmarkSchedule> Schedules = GetSchedules(BoundedDistance);
+
+	FString Csv = TEXT("Mask,Resolution,Schedule,ErrorRate,MaxError,MeanError,Missed,ClampErrors,PayloadErrors,Milliseconds\n");
+	bool bPassed = true;
+
+	for (const FString& ResolutionName : ResolutionNames)
+	{
+		const int32 Resolution = FCString::Atoi(*ResolutionName);
+		if (Resolution <= 0 || Resolution > FJumpFloodCPU::MaxSize)
+		{
+			UE_LOG(LogJumpFloodBenchmark, Error, TEXT("Skipping resolution %s"), *ResolutionName);
+			bPassed = false;
+			continue;
+		}
+
+		const FIntPoint Size = FIntPoint(Resolution, Resolution);
+
+		for (const FJumpFloodBenchmarkMask& Mask : JumpFloodBenchmarkMasks)
+		{
+			TArray<uint8> Stencil;
+			TArray<int64> ReferenceDistancesSquared;
+			GenerateMask(Mask, Size, Stencil, ReferenceDistancesSquared);
+
+			float BaselineErrorRate = 0.0f;
+
+			for (int32 ScheduleIndex = 0; ScheduleIndex < Schedules.Num(); ++ScheduleIndex)
+			{
+				const FJumpFloodBenchmarkSchedule& Schedule = Schedules[ScheduleIndex];
+				const FJumpFloodBenchmarkResult Result = RunSchedule(Size, Stencil, ReferenceDistancesSquared, Schedule.Settings, IterationCount);
+
+				if (ScheduleIndex == 0)
+				{
+					BaselineErrorRate = Result.ErrorRate;
+				}
+
+				UE_LOG(LogJumpFloodBenchmark, Display, TEXT("%-10s %5d %-14s error rate %8.5f%%  max %7.3f  mean %7.3f  missed %6lld  clamp %lld  payload %lld  %9.2f ms"),
+					Mask.Name, Resolution, Schedule.Name, Result.ErrorRate * 100.0f, Result.MaxError, Result.MeanError, Result.MissedCount, Result.ClampErrorCount, Result.PayloadErrorCount, Result.Milliseconds);
+
+				Csv += FString::Printf(TEXT("%s,%d,%s,%f,%f,%f,%lld,%lld,%lld,%f\n"),
+					Mask.Name, Resolution, Schedule.Name, Result.ErrorRate, Result.MaxError, Result.MeanError, Result.MissedCount, Result.ClampErrorCount, Result.PayloadErrorCount, Result.Milliseconds);
+
+				const FString Failure = GetScheduleFailure(Schedule, Result, bFixedMaxErrorRate ? MaxErrorRate : BaselineErrorRate + ErrorRateEpsilon);
+				if (!Failure.IsEmpty())
+				{
+					UE_LOG(LogJumpFloodBenchmark, Error, TEXT("%s on %s at %d %s"), Schedule.Name, Mask.Name, Resolution, *Failure);
+					bPassed = false;
+				}
+			}
+		}
+	}
+
+	if (!FFileHelper::SaveStringToFile(Csv, *CsvPath))
+	{
+		UE_LOG(LogJumpFloodBenchmark, Error, TEXT("Could not write %s"), *CsvPath);
+		return 1;
+	}
+
+	UE_LOG(LogJumpFloodBenchmark, Display, TEXT("Wrote %s"), *CsvPath);
+	return bPassed ? 0 : 1;
+}
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FJumpFloodCPUGatesTest, "Plugins.JumpFloodPass.CPU.Gates", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+//  The benchmark's gates on every mask at small resolutions, quick enough to run with the other automation tests
+bool FJumpFloodCPUGatesTest::RunTest(const FString& Parameters)
+{
+	static constexpr float ErrorRateEpsilon = 0.001f;
+
+	const TArray<FJumpFloodBenchmarkSchedule> Schedules = GetSchedules(16.0f);
+
+	for (const int32 Resolution : { 64, 256 })
+	{
+		const FIntPoint Size = FIntPoint(Resolution, Resolution);
+
+		for (const FJumpFloodBenchmarkMask& Mask : JumpFloodBenchmarkMasks)
+		{
+			TArray<uint8> Stencil;
+			TArray<int64> ReferenceDistancesSquared;
+			GenerateMask(Mask, Size, Stencil, ReferenceDistancesSquared);
+
+			float BaselineErrorRate = 0.0f;
+
+			for (int32 ScheduleIndex = 0; ScheduleIndex < Schedules.Num(); ++ScheduleIndex)
+			{
+				const FJumpFloodBenchmarkSchedule& Schedule = Schedules[ScheduleIndex];
+				const FJumpFloodBenchmarkResult Result = RunSchedule(Size, Stencil, ReferenceDistancesSquared, Schedule.Settings, 1);
+
+				if (ScheduleIndex == 0)
+				{
+					BaselineErrorRate = Result.ErrorRate;
+				}
+
+				const FString Failure = GetScheduleFailure(Schedule, Result, BaselineErrorRate + ErrorRateEpsilon);
+				if (!Failure.IsEmpty())
+				{
+					AddError(FString::Printf(TEXT("%s on %s at %d %s"), Schedule.Name, Mask.Name, Resolution, *Failure));
+				}
+			}
+		}
+	}
+
+	return !HasAnyErrors();
+}
+
+#endif
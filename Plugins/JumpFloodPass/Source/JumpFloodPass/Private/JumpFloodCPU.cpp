@@ -0,0 +1,387 @@
+// Copyright James Maiden. All Rights Reserved.
+#include "JumpFloodCPU.h"
+
+#include "Async/ParallelFor.h"
+
+//  Rows or columns handed to each parallel task, enough to keep scheduling cost well below the work in a band
+static constexpr int32 JumpFloodCPUBandSize = 16;
+
+//  Squared distance given to "no seed", which never wins against a real one
+static constexpr uint32 JumpFloodCPUNoSeedDistance = MAX_uint32;
+
+template<typename FunctionType>
+static void ParallelForBands(int32 Count, FunctionType&& Function)
+{
+	const int32 BandCount = FMath::DivideAndRoundUp(Count, JumpFloodCPUBandSize);
+	ParallelFor(BandCount, [Count, &Function](int32 BandIndex)
+	{
+		const int32 Begin = BandIndex * JumpFloodCPUBandSize;
+		Function(Begin, FMath::Min(Begin + JumpFloodCPUBandSize, Count));
+	});
+}
+
+//  Branch free, so that the row loops using it vectorize
+static FORCEINLINE uint32 SeedSquareDistance(int32 X, int32 Y, uint32 PackedSeed)
+{
+	const int32 DeltaX = X - ((int32) (PackedSeed & 0xFFFF) - 1);
+	const int32 DeltaY = Y - ((int32) (PackedSeed >> 16) - 1);
+	const uint32 NoSeedMask = 0u - (uint32) (PackedSeed == 0);
+	return ((uint32) (DeltaX * DeltaX) + (uint32) (DeltaY * DeltaY)) | NoSeedMask;
+}
+
+void FJumpFloodCPU::Seed(const FIntPoint& Size, TConstArrayView<uint8> Stencil, TArrayView<uint32> OutSeeds)
+{
+	check(Stencil.Num() == Size.X * Size.Y && OutSeeds.Num() == Size.X * Size.Y);
+
+	//  Same kernels and indexing as SobelEdgeDetection in JumpFloodPass.usf, with texels outside the mask reading as 0. Each band
+	//  copies its rows into a zero bordered block first, so the row loops below have no bounds checks and vectorize
+	ParallelForBands(Size.Y, [&Size, &Stencil, &OutSeeds](int32 RowBegin, int32 RowEnd)
+	{
+		const int32 PaddedWidth = Size.X + 2;
+
+		TArray<int32> PaddedRows;
+		PaddedRows.SetNumZeroed((RowEnd - RowBegin + 2) * PaddedWidth);
+
+		for (int32 Y = FMath::Max(RowBegin - 1, 0); Y < FMath::Min(RowEnd + 1, Size.Y); ++Y)
+		{
+			const uint8* RESTRICT StencilRow = Stencil.GetData() + (int64) Y * Size.X;
+			int32* RESTRICT PaddedRow = PaddedRows.GetData() + (Y - RowBegin + 1) * PaddedWidth + 1;
+
+			for (int32 X = 0; X < Size.X; ++X)
+			{
+				PaddedRow[X] = StencilRow[X];
+			}
+		}
+
+		for (int32 Y = RowBegin; Y < RowEnd; ++Y)
+		{
+			const int32* RESTRICT Center = PaddedRows.GetData() + (Y - RowBegin + 1) * PaddedWidth + 1;
+			const int32* RESTRICT Above = Center - PaddedWidth;
+			const int32* RESTRICT Below = Center + PaddedWidth;
+			uint32* RESTRICT SeedRow = OutSeeds.GetData() + (int64) Y * Size.X;
+
+			for (int32 X = 0; X < Size.X; ++X)
+			{
+				const int32 Gx = (Below[X - 1] + 2 * Below[X] + Below[X + 1]) - (Above[X - 1] + 2 * Above[X] + Above[X + 1]);
+				const int32 Gy = (Above[X + 1] + 2 * Center[X + 1] + Below[X + 1]) - (Above[X - 1] + 2 * Center[X - 1] + Below[X - 1]);
+
+				//  Gx * Gx + Gy * Gy > 0 without the multiplies, and only on texels inside the mask
+				const uint32 EdgeMask = 0u - (uint32) (((Gx | Gy) != 0) & (Center[X] != 0));
+				SeedRow[X] = PackSeed(X, Y) & EdgeMask;
+			}
+		}
+	});
+}
+
+static void FloodStep(const FIntPoint& Size, const uint32* ReadSeeds, uint32* WriteSeeds, int32 StepSize)
+{
+	ParallelForBands(Size.Y, [&Size, ReadSeeds, WriteSeeds, StepSize](int32 RowBegin, int32 RowEnd)
+	{
+		TArray<uint32> BestDistanceRow;
+		BestDistanceRow.SetNumUninitialized(Size.X);
+
+		for (int32 Y = RowBegin; Y < RowEnd; ++Y)
+		{
+			const uint32* RESTRICT ReadRow = ReadSeeds + (int64) Y * Size.X;
+			uint32* RESTRICT BestSeeds = WriteSeeds + (int64) Y * Size.X;
+			uint32* RESTRICT BestDistances = BestDistanceRow.GetData();
+
+			for (int32 X = 0; X < Size.X; ++X)
+			{
+				BestSeeds[X] = ReadRow[X];
+				BestDistances[X] = SeedSquareDistance(X, Y, ReadRow[X]);
+			}
+
+			//  Neighbours in the same order as FloodSample, a whole row at a time so the inner loop has no bounds checks and
+			//  vectorizes
+			for (int32 OffsetX = -1; OffsetX <= 1; ++OffsetX)
+			{
+				for (int32 OffsetY = -1; OffsetY <= 1; ++OffsetY)
+				{
+					if (OffsetX == 0 && OffsetY == 0) continue;
+
+					const int32 SampleY = Y + OffsetY * StepSize;
+					if (SampleY < 0 || SampleY >= Size.Y) continue;
+
+					const int32 DeltaX = OffsetX * StepSize;
+					const uint32* RESTRICT SampleRow = ReadSeeds + (int64) SampleY * Size.X + DeltaX;
+
+					const int32 XBegin = FMath::Max(0, -DeltaX);
+					const int32 XEnd = FMath::Min(Size.X, Size.X - DeltaX);
+
+					for (int32 X = XBegin; X < XEnd; ++X)
+					{
+						const uint32 SampleSeed = SampleRow[X];
+						const uint32 DistanceSquared = SeedSquareDistance(X, Y, SampleSeed);
+
+						const uint32 CloserMask = 0u - (uint32) (DistanceSquared < BestDistances[X]);
+						BestSeeds[X] = (SampleSeed & CloserMask) | (BestSeeds[X] & ~CloserMask);
+						BestDistances[X] = (DistanceSquared & CloserMask) | (BestDistances[X] & ~CloserMask);
+					}
+				}
+			}
+		}
+	});
+}
+
+void FJumpFloodCPU::Flood(const FIntPoint& Size, TArrayView<uint32> InOutSeeds, const FJumpFloodCPUSettings& Settings)
+{
+	check(InOutSeeds.Num() == Size.X * Size.Y);
+
+	const float LargestSide = FMath::Max(Size.X, Size.Y);
+	int32 FloodPassCount = (int32) FMath::Log2(LargestSide);
+
+	if (Settings.MaxDistance > 0.0f)
+	{
+		FloodPassCount = FMath::Min(FloodPassCount, FMath::CeilToInt(FMath::Log2(FMath::Max(Settings.MaxDistance, 1.0f) + 1.0f)) - 1);
+	}
+
+	TArray<uint32> Scratch;
+	Scratch.SetNumUninitialized(InOutSeeds.Num());
+
+	uint32* ReadSeeds = InOutSeeds.GetData();
+	uint32* WriteSeeds = Scratch.GetData();
+
+	//  Adding a 1-step pass before full flood reduces error rate
+	for (int32 StepIndex = 0; StepIndex < Settings.LeadingUnitStepCount; ++StepIndex)
+	{
+		FloodStep(Size, ReadSeeds, WriteSeeds, 1);
+		Swap(ReadSeeds, WriteSeeds);
+	}
+
+	for (int32 FloodExponent = FloodPassCount; FloodExponent >= 0; --FloodExponent)
+	{
+		FloodStep(Size, ReadSeeds, WriteSeeds, 1 << FloodExponent);
+		Swap(ReadSeeds, WriteSeeds);
+	}
+
+	for (int32 FloodExponent = Settings.TrailingStepCount - 1; FloodExponent >= 0; --FloodExponent)
+	{
+		FloodStep(Size, ReadSeeds, WriteSeeds, 1 << FloodExponent);
+		Swap(ReadSeeds, WriteSeeds);
+	}
+
+	if (ReadSeeds != InOutSeeds.GetData())
+	{
+		FMemory::Memcpy(InOutSeeds.GetData(), ReadSeeds, InOutSeeds.Num() * sizeof(uint32));
+	}
+}
+
+void FJumpFloodCPU::FloodExact(const FIntPoint& Size, TArrayView<uint32> InOutSeeds)
+{
+	check(InOutSeeds.Num() == Size.X * Size.Y);
+
+	//  Nearest seed along each row, by a scan in each direction
+	TArray<int32> RowNearestX;
+	RowNearestX.SetNumUninitialized(InOutSeeds.Num());
+
+	ParallelForBands(Size.Y, [&Size, &InOutSeeds, &RowNearestX](int32 RowBegin, int32 RowEnd)
+	{
+		for (int32 Y = RowBegin; Y < RowEnd; ++Y)
+		{
+			const uint32* SeedRow = InOutSeeds.GetData() + (int64) Y * Size.X;
+			int32* NearestRow = RowNearestX.GetData() + (int64) Y * Size.X;
+
+			int32 LastSeedX = INDEX_NONE;
+			for (int32 X = 0; X < Size.X; ++X)
+			{
+				LastSeedX = SeedRow[X] != 0 ? X : LastSeedX;
+				NearestRow[X] = LastSeedX;
+			}
+
+			LastSeedX = INDEX_NONE;
+			for (int32 X = Size.X - 1; X >= 0; --X)
+			{
+				LastSeedX = SeedRow[X] != 0 ? X : LastSeedX;
+				if (LastSeedX != INDEX_NONE && (NearestRow[X] == INDEX_NONE || LastSeedX - X < X - NearestRow[X]))
+				{
+					NearestRow[X] = LastSeedX;
+				}
+			}
+		}
+	});
+
+	//  Lower envelope of the parabolas rooted at each row's nearest seed, down every column
+	TArray<uint32> ExactSeeds;
+	ExactSeeds.SetNumUninitialized(InOutSeeds.Num());
+
+	ParallelForBands(Size.X, [&Size, &InOutSeeds, &RowNearestX, &ExactSeeds](int32 ColumnBegin, int32 ColumnEnd)
+	{
+		const int32 ColumnCount = ColumnEnd - ColumnBegin;
+
+		//  Gathered a band of columns at a time so reads walk along rows
+		TArray<int32> ColumnNearestX;
+		ColumnNearestX.SetNumUninitialized(ColumnCount * Size.Y);
+
+		for (int32 Y = 0; Y < Size.Y; ++Y)
+		{
+			for (int32 Column = 0; Column < ColumnCount; ++Column)
+			{
+				ColumnNearestX[Column * Size.Y + Y] = RowNearestX[Y * Size.X + ColumnBegin + Column];
+			}
+		}
+
+		TArray<int32> Sites;
+		TArray<double> Boundaries;
+		TArray<uint32> ColumnSeeds;
+		Sites.SetNumUninitialized(Size.Y);
+		Boundaries.SetNumUninitialized(Size.Y);
+		ColumnSeeds.SetNumUninitialized(ColumnCount * Size.Y);
+
+		for (int32 Column = 0; Column < ColumnCount; ++Column)
+		{
+			const int32 X = ColumnBegin + Column;
+			const int32* NearestX = ColumnNearestX.GetData() + Column * Size.Y;
+
+			auto Height = [X, NearestX](int32 Q) { return FMath::Square((double) (X - NearestX[Q])) + FMath::Square((double) Q); };
+
+			int32 SiteCount = 0;
+			for (int32 Q = 0; Q < Size.Y; ++Q)
+			{
+				if (NearestX[Q] == INDEX_NONE) continue;
+
+				double Intersection = 0.0;
+				while (SiteCount > 0)
+				{
+					const int32 Previous = Sites[SiteCount - 1];
+					Intersection = (Height(Q) - Height(Previous)) / (2.0 * (Q - Previous));
+					if (Intersection > Boundaries[SiteCount - 1])
+					{
+						break;
+					}
+
+					--SiteCount;
+				}
+
+				Sites[SiteCount] = Q;
+				Boundaries[SiteCount] = SiteCount == 0 ? -MAX_dbl : Intersection;
+				++SiteCount;
+			}
+
+			uint32* Output = ColumnSeeds.GetData() + Column * Size.Y;
+			if (SiteCount == 0)
+			{
+				FMemory::Memzero(Output, Size.Y * sizeof(uint32));
+				continue;
+			}
+
+			int32 SiteIndex = 0;
+			for (int32 Y = 0; Y < Size.Y; ++Y)
+			{
+				while (SiteIndex + 1 < SiteCount && Boundaries[SiteIndex + 1] < Y)
+				{
+					++SiteIndex;
+				}
+
+				const int32 SiteY = Sites[SiteIndex];
+				Output[Y] = InOutSeeds[SiteY * Size.X + NearestX[SiteY]];
+			}
+		}
+
+		for (int32 Y = 0; Y < Size.Y; ++Y)
+		{
+			for (int32 Column = 0; Column < ColumnCount; ++Column)
+			{
+				ExactSeeds[Y * Size.X + ColumnBegin + Column] = ColumnSeeds[Column * Size.Y + Y];
+			}
+		}
+	});
+
+	FMemory::Memcpy(InOutSeeds.GetData(), ExactSeeds.GetData(), InOutSeeds.Num() * sizeof(uint32));
+}
+
+void FJumpFloodCPU::Resolve(
+	const FIntPoint& Size,
+	TConstArrayView<uint32> Seeds,
+	TConstArrayView<uint8> Stencil,
+	TConstArrayView<float> Depth,
+	float MaxDistance,
+	TArrayView<FVector4f> OutPrimary,
+	TArrayView<FVector4f> OutSecondary)
+{
+	const int32 TexelCount = Size.X * Size.Y;
+	check(Seeds.Num() == TexelCount && Stencil.Num() == TexelCount && (Depth.IsEmpty() || Depth.Num() == TexelCount));
+	check(OutPrimary.Num() == TexelCount && (OutSecondary.IsEmpty() || OutSecondary.Num() == TexelCount));
+
+	const bool bResolveSecondary = !OutSecondary.IsEmpty();
+
+	const FVector2f TextureSizeInverse = FVector2f(1.0f, 1.0f) / FVector2f(Size);
+
+	//  A bounded flood can still reach seeds past MaxDistance, so anything outside the stencil beyond it is reported as having no
+	//  seed. Texels inside keep their seed with the distance held at -MaxDistance. Unbounded, no distance is ever past the limit
+	const float DistanceLimit = MaxDistance > 0.0f ? MaxDistance : MAX_flt;
+
+	ParallelForBands(Size.Y, [&](int32 RowBegin, int32 RowEnd)
+	{
+		for (int32 Y = RowBegin; Y < RowEnd; ++Y)
+		{
+			const uint32* RESTRICT SeedRow = Seeds.GetData() + (int64) Y * Size.X;
+			const uint8* RESTRICT StencilRow = Stencil.GetData() + (int64) Y * Size.X;
+			FVector4f* RESTRICT PrimaryRow = OutPrimary.GetData() + (int64) Y * Size.X;
+
+			//  Selects instead of branches on whether a seed is kept, so the row vectorizes. Texels without a seed compute a
+			//  distance from the no seed sentinel and are then masked to zero like the GPU resolve
+			for (int32 X = 0; X < Size.X; ++X)
+			{
+				const uint32 PackedSeed = SeedRow[X];
+				const float Sign = StencilRow[X] > 0 ? -1.0f : 1.0f;
+				const float SignedDistance = FMath::Sqrt((float) SeedSquareDistance(X, Y, PackedSeed)) * Sign;
+				const bool bKeep = (PackedSeed != 0) & (SignedDistance <= DistanceLimit);
+
+				PrimaryRow[X].X = bKeep ? ((float) (PackedSeed & 0xFFFF) - 0.5f) * TextureSizeInverse.X : 0.0f;
+				PrimaryRow[X].Y = bKeep ? ((float) (PackedSeed >> 16) - 0.5f) * TextureSizeInverse.Y : 0.0f;
+				PrimaryRow[X].Z = bKeep ? FMath::Max(SignedDistance, -DistanceLimit) : 0.0f;
+				PrimaryRow[X].W = bKeep ? 1.0f : 0.0f;
+			}
+
+			if (!bResolveSecondary)
+			{
+				continue;
+			}
+
+			//  Gathers from the seed texel, so only the kept seeds are looked up
+			FVector4f* RESTRICT SecondaryRow = OutSecondary.GetData() + (int64) Y * Size.X;
+
+			for (int32 X = 0; X < Size.X; ++X)
+			{
+				const uint32 PackedSeed = PrimaryRow[X].W > 0.0f ? SeedRow[X] : 0;
+				const FIntPoint SeedPosition = UnpackSeed(PackedSeed);
+				const int32 SeedIndex = SeedPosition.Y * Size.X + SeedPosition.X;
+
+				SecondaryRow[X] = PackedSeed != 0
+					? FVector4f(Stencil[SeedIndex], Depth.IsEmpty() ? 0.0f : Depth[SeedIndex], 0.0f, 0.0f)
+					: FVector4f(0.0f, 0.0f, 0.0f, 0.0f);
+			}
+		}
+	});
+}
+
+FJumpFloodCPUField FJumpFloodCPU::Compute(const FIntPoint& Size, TConstArrayView<uint8> Stencil, const FJumpFloodCPUSettings& Settings)
+{
+	checkf(Size.X > 0 && Size.Y > 0 && Size.X <= MaxSize && Size.Y <= MaxSize, TEXT("Mask of %dx%d cannot be flooded"), Size.X, Size.Y);
+
+	TArray<uint32> Seeds;
+	Seeds.SetNumUninitialized(Size.X * Size.Y);
+
+	Seed(Size, Stencil, Seeds);
+
+	if (Settings.Method == EJumpFloodCPUMethod::ExactEDT)
+	{
+		FloodExact(Size, Seeds);
+	}
+	else
+	{
+		Flood(Size, Seeds, Settings);
+	}
+
+	FJumpFloodCPUField Field;
+	Field.Size = Size;
+	Field.Primary.SetNumUninitialized(Seeds.Num());
+	if (Settings.bResolveSecondary)
+	{
+		Field.Secondary.SetNumUninitialized(Seeds.Num());
+	}
+
+	Resolve(Size, Seeds, Stencil, {}, Settings.MaxDistance, Field.Primary, Field.Secondary);
+	return Field;
+}
@@ -1,12 +1,24 @@
 #include "JumpFloodPassSceneViewExtension.h"
 #include "JumpFloodPassSettings.h"
 
+#include "CommonRenderResources.h"
 #include "DynamicResolutionState.h"
+#include "DynamicRHI.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "Materials/MaterialInterface.h"
+#include "Materials/MaterialParameterCollection.h"
+#include "Materials/MaterialParameterCollectionInstance.h"
+#include "PipelineStateCache.h"
 #include "PixelShaderUtils.h"
 #include "PostProcess/PostProcessing.h"
 #include "PostProcess/PostProcessMaterial.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+#include "RenderGraphBlackboard.h"
 #include "RenderGraphBuilder.h"
 #include "RenderGraphEvent.h"
+#include "RenderGraphUtils.h"
 #include "RenderTargetPool.h"
 #include "RHI.h"
 #include "SceneRendering.h"
@@ -14,6 +26,10 @@
 #include "SceneTextureParameters.h"
 #include "SceneView.h"
 #include "ScreenPass.h"
+#include "StereoRendering.h"
+#include "SystemTextures.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogJumpFloodPass, Log, All);
 
 TAutoConsoleVariable<float> CVarJumpFloodRenderScale(
 	TEXT("r.JumpFloodPass.RenderScale"),
@@ -21,28 +37,418 @@ TAutoConsoleVariable<float> CVarJumpFloodRenderScale(
 	TEXT("Value to scale Jump Flooding render textures by. 1.0 scale is used when value is <= 0\n"),
 	ECVF_RenderThreadSafe);
 
-BEGIN_SHADER_PARAMETER_STRUCT(FJumpFloodPassParams,)
+TAutoConsoleVariable<int32> CVarJumpFloodCompute(
+	TEXT("r.JumpFloodPass.Compute"),
+	0,
+	TEXT("Selects how the flood steps are run.\n")
+	TEXT(" 0: One fullscreen pixel shader pass per step (default)\n")
+	TEXT(" 1: Compute shaders. Steps smaller than the tile size are flooded together in groupshared memory in a single dispatch\n"),
+	ECVF_RenderThreadSafe);
+
+TAutoConsoleVariable<int32> CVarJumpFloodPackedIntermediate(
+	TEXT("r.JumpFloodPass.PackedIntermediate"),
+	0,
+	TEXT("When enabled, the flood ping-pong textures store a single packed R32_UINT seed coordinate instead of two float4 textures.\n")
+	TEXT("Stencil and depth are then looked up from the seed during the resolve instead of being propagated by every flood step.\n"),
+	ECVF_RenderThreadSafe);
+
+TAutoConsoleVariable<float> CVarJumpFloodMaxDistance(
+	TEXT("r.JumpFloodPass.MaxDistance"),
+	-1.0f,
+	TEXT("Furthest distance, in output pixels, that the flood needs to reach. Caps the largest flood step. Anything further outside the stencil resolves as having no seed,\n")
+	TEXT("and anything further inside it has its distance held at -MaxDistance.\n")
+	TEXT(" <0: Use MaxFloodDistance from the project settings (default)\n")
+	TEXT("  0: Unbounded, flood the whole view\n"),
+	ECVF_RenderThreadSafe);
+
+TAutoConsoleVariable<int32> CVarJumpFloodTileClassification(
+	TEXT("r.JumpFloodPass.TileClassification"),
+	1,
+	TEXT("When the flood is bounded (r.JumpFloodPass.MaxDistance) and runs in compute (r.JumpFloodPass.Compute), only flood and resolve\n")
+	TEXT("the tiles that hold a seed or lie within the bounded radius of one, using indirect dispatches and draws. The rest of the output is cleared.\n"),
+	ECVF_RenderThreadSafe);
+
+TAutoConsoleVariable<int32> CVarJumpFloodTemporal(
+	TEXT("r.JumpFloodPass.Temporal"),
+	0,
+	TEXT("When enabled and the flood runs in compute (r.JumpFloodPass.Compute), keeps the previous frame's result while the view and its\n")
+	TEXT("custom stencil are unchanged, and only re-floods and resolves the tiles around where the stencil or depth under it changed.\n")
+	TEXT("Unbounded floods (r.JumpFloodPass.MaxDistance) re-flood the whole view as soon as anything changed.\n")
+	TEXT("Tiles are compared by a coarse summary of their stencil and depth, so the jitter of TAA/TSR alone doesn't re-flood them, at the\n")
+	TEXT("cost of edges that drift by up to about a texel before their tiles are. Views without a view state, such as most scene\n")
+	TEXT("captures, always flood in full.\n"),
+	ECVF_RenderThreadSafe);
+
+TAutoConsoleVariable<int32> CVarJumpFloodPostProcessInput(
+	TEXT("r.JumpFloodPass.PostProcessInput"),
+	0,
+	TEXT("Selects where the distance field ends up.\n")
+	TEXT(" 0: Resolved into the Primary and Secondary render target assets from the project settings (default)\n")
+	TEXT(" 1: The last flood step writes the field into transient textures at intermediate resolution, which are bound as PostProcessInput3\n")
+	TEXT("    (Primary) and PostProcessInput4 (Secondary) of the PostProcessMaterial from the project settings, run after tonemapping.\n")
+	TEXT("    Skips the resolve pass and the render target assets entirely. Only that material sees the field, and always after tonemapping\n")
+	TEXT("    whatever its blendable location. Temporal reuse (r.JumpFloodPass.Temporal) is off, so every view floods in full\n"),
+	ECVF_RenderThreadSafe);
+
+TAutoConsoleVariable<int32> CVarJumpFloodAsyncCompute(
+	TEXT("r.JumpFloodPass.AsyncCompute"),
+	0,
+	TEXT("When enabled and the flood runs in compute (r.JumpFloodPass.Compute), flood passes run on the async compute queue where the\n")
+	TEXT("platform supports it efficiently, overlapping the shadow and lighting work after the base pass. Seeding stays on the graphics queue\n")
+	TEXT("and the resolve into the render targets moves to just before post processing, which is where the two queues join. View families\n")
+	TEXT("without post processing resolve straight after their flood.\n"),
+	ECVF_RenderThreadSafe);
+
+TAutoConsoleVariable<int32> CVarJumpFloodHierarchical(
+	TEXT("r.JumpFloodPass.Hierarchical"),
+	0,
+	TEXT("Number of times, up to 3, the seeds are halved in resolution before the long range flood steps, which then run on that coarse\n")
+	TEXT("level. The result is upsampled, keeping every full resolution seed, and the tile pass refines the short range steps at full resolution.\n")
+	TEXT("Selects r.JumpFloodPass.Compute and r.JumpFloodPass.PackedIntermediate on SM5, and is not used for tile listed (bounded or temporal) floods.\n"),
+	ECVF_RenderThreadSafe);
+
+TAutoConsoleVariable<int32> CVarJumpFloodExact(
+	TEXT("r.JumpFloodPass.Exact"),
+	0,
+	TEXT("When enabled, the flood steps are replaced by an exact euclidean distance transform, run as a pass along the rows and passes\n")
+	TEXT("along the columns, each split into bands that run in parallel and are merged at their seams. Its field has none of the jump flood's\n")
+	TEXT("errors on thin features. Selects r.JumpFloodPass.Compute and r.JumpFloodPass.PackedIntermediate on SM5, and takes the place of the\n")
+	TEXT("hierarchy and refinement passes.\n"),
+	ECVF_RenderThreadSafe);
+
+TAutoConsoleVariable<int32> CVarJumpFloodAmortizeFrames(
+	TEXT("r.JumpFloodPass.AmortizeFrames"),
+	1,
+	TEXT("Number of frames, up to 4, that each flood's steps are spread over, cutting the flood's cost per frame by as much.\n")
+	TEXT("The seeds and ping-pong textures are kept between frames, and each frame resolves the last completed flood, reprojected\n")
+	TEXT("by the camera's motion since its seeds were taken. Objects that move on their own lag by as many frames.\n")
+	TEXT("Needs r.JumpFloodPass.Compute and r.JumpFloodPass.PackedIntermediate, and is not used for side by side stereo or with\n")
+	TEXT("r.JumpFloodPass.Exact, temporal reuse, tile classification or views without a view state, such as most scene captures.\n")
+	TEXT("Camera cuts, and any frame with seed sources registered, flood in full within the frame.\n"),
+	ECVF_RenderThreadSafe);
+
+TAutoConsoleVariable<int32> CVarJumpFloodStencilSeeds(
+	TEXT("r.JumpFloodPass.StencilSeeds"),
+	1,
+	TEXT("When enabled, seeds the flood from the edges of custom stencil. Disabling it leaves only the seed sources registered with\n")
+	TEXT("UJumpFloodPassSubsystem, skipping the full screen edge detection and the need to draw anything into custom depth.\n"),
+	ECVF_RenderThreadSafe);
+
+TAutoConsoleVariable<int32> CVarJumpFloodPayload(
+	TEXT("r.JumpFloodPass.Payload"),
+	1,
+	TEXT("When enabled, the field's Secondary output holds the stencil and depth at each texel's seed. Disabling it writes zero there instead,\n")
+	TEXT("and floods unpacked intermediates without their Secondary texture, for when nothing reads more than the distance and seed UV.\n"),
+	ECVF_RenderThreadSafe);
+
+TAutoConsoleVariable<int32> CVarJumpFloodSeedEdgeDetection(
+	TEXT("r.JumpFloodPass.SeedEdgeDetection"),
+	0,
+	TEXT("How the seed pass finds the edges of custom stencil.\n")
+	TEXT(" 0: 3x3 Sobel filter (default)\n")
+	TEXT(" 1: Compare with the four direct neighbours. Half the stencil reads, but edges that only meet diagonally are not seeded\n"),
+	ECVF_RenderThreadSafe);
+
+TAutoConsoleVariable<int32> CVarJumpFloodGroups(
+	TEXT("r.JumpFloodPass.Groups"),
+	0,
+	TEXT("Floods up to four groups of custom stencil at once, each in its own channel, so groups that meet don't cut into each other's field.\n")
+	TEXT(" 0: Off, a single field to the nearest seed of any stencil (default)\n")
+	TEXT(" 1: Stencil values 1 to 4 are groups 0 to 3\n")
+	TEXT(" 2: Each of the stencil's lowest four bits is a group, so a texel can be in several\n")
+	TEXT("Primary then holds each group's signed distance in output pixels, or 65504 where it has no seed in reach, and with the payload\n")
+	TEXT("Secondary holds the scene depth at each group's seed. Needs SM5, and leaves out temporal reuse, tile lists, the hierarchy and field queries.\n"),
+	ECVF_RenderThreadSafe);
+
+TAutoConsoleVariable<int32> CVarJumpFloodRefinementPasses(
+	TEXT("r.JumpFloodPass.RefinementPasses"),
+	0,
+	TEXT("Extra flood steps of 2^(N-1) down to 1 texels run after the full flood, making it JFA+N. Fixes most of the texels JFA alone gets wrong.\n"),
+	ECVF_RenderThreadSafe);
+
+TAutoConsoleVariable<float> CVarJumpFloodBudget(
+	TEXT("r.JumpFloodPass.Budget"),
+	-1.0f,
+	TEXT("GPU time, in ms, that each frame's floods should fit in. The render scale, flood passes and refinement passes are lowered while\n")
+	TEXT("the floods run over it, and raised again once they fit with room to spare. Floods stay off the async compute queue while budgeted,\n")
+	TEXT("so their time can be told apart from the work they would overlap.\n")
+	TEXT("0 turns budgeting off. Negative uses the project setting.\n"),
+	ECVF_RenderThreadSafe);
+
+TAutoConsoleVariable<float> CVarJumpFloodBudgetMinRenderScale(
+	TEXT("r.JumpFloodPass.BudgetMinRenderScale"),
+	0.5f,
+	TEXT("Smallest fraction of r.JumpFloodPass.RenderScale the budget can scale the floods down to.\n"),
+	ECVF_RenderThreadSafe);
+
+TAutoConsoleVariable<int32> CVarJumpFloodBudgetMaxFloodPassReduction(
+	TEXT("r.JumpFloodPass.BudgetMaxFloodPassReduction"),
+	2,
+	TEXT("Most of the largest flood steps the budget can leave out once the render scale is as low as it goes. Each one halves how far the flood reaches.\n"),
+	ECVF_RenderThreadSafe);
+
+TAutoConsoleVariable<int32> CVarJumpFloodTargetSizeBucket(
+	TEXT("r.JumpFloodPass.TargetSizeBucket"),
+	256,
+	TEXT("The render target assets are sized up to a multiple of this many pixels, so small changes to the views' size don't reallocate them.\n")
+	TEXT("0 sizes them to exactly fit the views.\n"),
+	ECVF_Default);
+
+TAutoConsoleVariable<int32> CVarJumpFloodTargetShrinkDelay(
+	TEXT("r.JumpFloodPass.TargetShrinkDelay"),
+	300,
+	TEXT("Frames the views have to need a smaller bucket for before the render target assets are shrunk to it. They always grow straight away.\n"),
+	ECVF_Default);
+
+TAutoConsoleVariable<int32> CVarJumpFloodViewTypes(
+	TEXT("r.JumpFloodPass.ViewTypes"),
+	1,
+	TEXT("Bitmask of the kinds of view that are flooded. Reflection captures never are.\n")
+	TEXT(" 1: Game views (default)\n")
+	TEXT(" 2: Scene captures and planar reflections\n")
+	TEXT(" 4: Every other view, such as editor viewports and thumbnails\n"),
+	ECVF_RenderThreadSafe);
+
+DECLARE_STATS_GROUP(TEXT("JumpFlood"), STATGROUP_JumpFlood, STATCAT_Advanced);
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Views Flooded"), STAT_JumpFloodViewsFlooded, STATGROUP_JumpFlood);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Views Skipped (Nothing To Seed)"), STAT_JumpFloodViewsSkippedEmpty, STATGROUP_JumpFlood);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Views Skipped (View Type)"), STAT_JumpFloodViewsSkippedViewType, STATGROUP_JumpFlood);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Seed Pieces Dropped"), STAT_JumpFloodSeedPiecesDropped, STATGROUP_JumpFlood);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Transient Texture Memory (KB)"), STAT_JumpFloodTransientMemory, STATGROUP_JumpFlood);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Persistent Texture Memory (KB)"), STAT_JumpFloodPersistentMemory, STATGROUP_JumpFlood);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Temporal Dirty Tiles"), STAT_JumpFloodTemporalDirtyTiles, STATGROUP_JumpFlood);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Temporal Tiles"), STAT_JumpFloodTemporalTiles, STATGROUP_JumpFlood);
+
+DECLARE_CYCLE_STAT(TEXT("Begin Render View Family"), STAT_JumpFloodBeginRenderViewFamily, STATGROUP_JumpFlood);
+DECLARE_CYCLE_STAT(TEXT("Flood Setup (Render Thread)"), STAT_JumpFloodFloodSetup, STATGROUP_JumpFlood);
+DECLARE_CYCLE_STAT(TEXT("Resolve Setup (Render Thread)"), STAT_JumpFloodResolveSetup, STATGROUP_JumpFlood);
+
+DECLARE_GPU_STAT_NAMED(JumpFlood, TEXT("Jump Flood"));
+
+CSV_DEFINE_CATEGORY(JumpFlood, true);
+
+//  Scene texture parameters of each view, created once per graph rather than by every pass that samples them
+struct FJumpFloodSceneTextureParameters
+{
+	TArray<TPair<const FViewInfo*, FSceneTextureShaderParameters>, TInlineAllocator<2>> Views;
+};
+
+RDG_REGISTER_BLACKBOARD_STRUCT(FJumpFloodSceneTextureParameters);
+
+static FSceneTextureShaderParameters GetSceneTextureParameters(FRDGBuilder& GraphBuilder, const FViewInfo& ViewInfo)
+{
+	FJumpFloodSceneTextureParameters& SceneTextureParameters = GraphBuilder.Blackboard.GetOrCreate<FJumpFloodSceneTextureParameters>();
+	for (const TPair<const FViewInfo*, FSceneTextureShaderParameters>& View : SceneTextureParameters.Views)
+	{
+		if (View.Key == &ViewInfo)
+		{
+			return View.Value;
+		}
+	}
+
+	return SceneTextureParameters.Views.Emplace_GetRef(
+		&ViewInfo,
+		CreateSceneTextureShaderParameters(GraphBuilder, ViewInfo.GetSceneTexturesChecked(), ViewInfo.GetFeatureLevel(), ESceneTextureSetupMode::All)).Value;
+}
+
+//  Memory counted by the stats, in KB
+static uint32 GetTextureMemoryKB(const FIntPoint& Extent, EPixelFormat Format)
+{
+	return (uint32) (((int64) Extent.X * Extent.Y * GPixelFormats[Format].BlockBytes) / 1024);
+}
+
+static void AddTextureMemoryStats(uint32 TransientKB, uint32 PersistentKB)
+{
+	INC_DWORD_STAT_BY(STAT_JumpFloodTransientMemory, TransientKB);
+	INC_DWORD_STAT_BY(STAT_JumpFloodPersistentMemory, PersistentKB);
+	CSV_CUSTOM_STAT(JumpFlood, TransientMemoryKB, (int32) TransientKB, ECsvCustomStatOp::Accumulate);
+	CSV_CUSTOM_STAT(JumpFlood, PersistentMemoryKB, (int32) PersistentKB, ECsvCustomStatOp::Accumulate);
+}
+
+//  Post process material inputs the published field is bound to, after the ones the engine fills for every post process material
+static constexpr EPostProcessMaterialInput JumpFloodPrimaryMaterialInput = (EPostProcessMaterialInput) 3;
+static constexpr EPostProcessMaterialInput JumpFloodSecondaryMaterialInput = (EPostProcessMaterialInput) 4;
+
+//  Vector of the viewport parameter collection set to the views' region of the render target assets, as (MinU, MinV, MaxU, MaxV)
+static const FName JumpFloodViewportParameterName(TEXT("JumpFloodViewport"));
+
+//  Budget controller. The smoothed cost has to leave the band from JumpFloodBudgetHeadroom to 1 times the budget before anything
+//  changes, and each change is given enough frames to show up in the timings before the next
+static constexpr float JumpFloodBudgetSmoothing = 0.25f;
+static constexpr float JumpFloodBudgetHeadroom = 0.8f;
+static constexpr int32 JumpFloodBudgetCooldownFrames = 8;
+static constexpr float JumpFloodBudgetRenderScaleStep = 1.0f / 32.0f;
+
+//  Frames of timings that can be waiting on the GPU before the oldest is given up on
+static constexpr int32 JumpFloodBudgetMaxPendingFrames = 6;
+
+//  Bits of r.JumpFloodPass.ViewTypes
+static constexpr int32 JumpFloodViewTypeGame = 1;
+static constexpr int32 JumpFloodViewTypeSceneCapture = 2;
+static constexpr int32 JumpFloodViewTypeOther = 4;
+
+//  Frames of field queries that can be on their way back from the GPU at once. Queries aren't sampled on frames that would need more
+static constexpr int32 JumpFloodFieldQueryReadbackCount = 4;
+
+//  Temporal floods' dirty tile counts that can be on their way back from the GPU at once, across every view
+static constexpr int32 JumpFloodDirtyTileReadbackCount = 8;
+
+//  View states that haven't been rendered for this many frames are dropped along with their history
+static constexpr uint32 JumpFloodViewStateTimeoutFrames = 120;
+
+//  Width and height of a compute flood tile. Must match THREADGROUP_SIZE in JumpFloodPass.usf
+static constexpr int32 JumpFloodTileSize = 8;
+
+//  Bands each column of the exact flood is split into. Must match EXACT_BAND_COUNT in JumpFloodPass.usf
+static constexpr int32 JumpFloodExactBandCount = 16;
+
+//  Width and height, in intermediate texels, of the most a single seed piece is rasterized over by one group
+static constexpr int32 JumpFloodSeedPieceSize = 64;
+
+//  Pieces past this many in a view are dropped, so they can be dispatched along a single dimension. Counted in
+//  STAT_JumpFloodSeedPiecesDropped, with a warning the first time any are
+static constexpr int32 JumpFloodMaxSeedPieces = 65535;
+
+//  Set in a seed piece's flags when it fills its bounds rather than seeding around its segment. Must match JumpFloodPass.usf
+static constexpr uint32 JumpFloodSeedPieceFillBounds = 0x100;
+
+//  Groups a grouped flood keeps seeds for, one per channel. Must match GROUP_COUNT in JumpFloodPass.usf
+static constexpr int32 JumpFloodGroupCount = 4;
+
+//  Bit per group that a stencil value belongs to, as GetStencilGroups in JumpFloodPass.usf
+static uint32 GetStencilGroups(uint32 Stencil, int32 GroupMode)
+{
+	if (GroupMode == 1)
+	{
+		return Stencil >= 1 && Stencil <= JumpFloodGroupCount ? 1u << (Stencil - 1) : 0;
+	}
+
+	return Stencil & ((1u << JumpFloodGroupCount) - 1);
+}
+
+//  Layout of the tile classification indirect arguments buffer, in uint32s
+static constexpr uint32 JumpFloodTileDispatchArgsOffset = 0;
+static constexpr uint32 JumpFloodTileDrawArgsOffset = 4;
+static constexpr uint32 JumpFloodTileArgsCount = 8;
+
+BEGIN_SHADER_PARAMETER_STRUCT(FJumpFloodSeedPassParams,)
 	SHADER_PARAMETER_STRUCT_REF(FViewUniformShaderParameters, View)
 	SHADER_PARAMETER_STRUCT_INCLUDE(FSceneTextureShaderParameters, SceneTextures)
 
+	SHADER_PARAMETER(FVector2f, ViewportMin)
 	SHADER_PARAMETER(FVector2f, ViewportSize)
-	SHADER_PARAMETER(FVector2f, TextureSize)
 	SHADER_PARAMETER(FVector2f, TextureSizeInverse)
+
+	RENDER_TARGET_BINDING_SLOTS()
+END_SHADER_PARAMETER_STRUCT()
+
+//  Intermediates a flood step reads, whichever layout they are in
+BEGIN_SHADER_PARAMETER_STRUCT(FJumpFloodFloodReadParams,)
+	SHADER_PARAMETER(float, ViewSplit)
 	SHADER_PARAMETER_RDG_TEXTURE(Texture2D, PrimaryTexture)
 	SHADER_PARAMETER_RDG_TEXTURE(Texture2D, SecondaryTexture)
+	SHADER_PARAMETER_RDG_TEXTURE(Texture2D<uint>, SeedTexture)
+END_SHADER_PARAMETER_STRUCT()
+
+//  What a flood step that resolves reads on top, from the view and the scene
+BEGIN_SHADER_PARAMETER_STRUCT(FJumpFloodResolveStepParams,)
+	SHADER_PARAMETER_STRUCT_REF(FViewUniformShaderParameters, View)
+	SHADER_PARAMETER_STRUCT_INCLUDE(FSceneTextureShaderParameters, SceneTextures)
+
+	SHADER_PARAMETER(FVector2f, ViewportMin)
+	SHADER_PARAMETER(FVector2f, ViewportSize)
+	SHADER_PARAMETER(FVector2f, TextureSizeInverse)
+	SHADER_PARAMETER(float, MaxDistance)
+	SHADER_PARAMETER_RDG_TEXTURE(Texture2D<uint>, SeedStencilTexture)
+END_SHADER_PARAMETER_STRUCT()
+
+BEGIN_SHADER_PARAMETER_STRUCT(FJumpFloodFloodPassParams,)
+	SHADER_PARAMETER_STRUCT_INCLUDE(FJumpFloodFloodReadParams, Flood)
+	SHADER_PARAMETER(float, FloodStepSize)
+	SHADER_PARAMETER(float, SeedSpaceScale)
 
+	RENDER_TARGET_BINDING_SLOTS()
+END_SHADER_PARAMETER_STRUCT()
+
+BEGIN_SHADER_PARAMETER_STRUCT(FJumpFloodFloodResolvePassParams,)
+	SHADER_PARAMETER_STRUCT_INCLUDE(FJumpFloodFloodReadParams, Flood)
 	SHADER_PARAMETER(float, FloodStepSize)
+	SHADER_PARAMETER(float, SeedSpaceScale)
+	SHADER_PARAMETER_STRUCT_INCLUDE(FJumpFloodResolveStepParams, Resolve)
+
+	RENDER_TARGET_BINDING_SLOTS()
+END_SHADER_PARAMETER_STRUCT()
+
+BEGIN_SHADER_PARAMETER_STRUCT(FJumpFloodCopyPassParams,)
+	SHADER_PARAMETER_STRUCT_REF(FViewUniformShaderParameters, View)
+	SHADER_PARAMETER_STRUCT_INCLUDE(FSceneTextureShaderParameters, SceneTextures)
+
+	SHADER_PARAMETER(FVector2f, ViewportMin)
+	SHADER_PARAMETER(FVector2f, TextureSize)
+	SHADER_PARAMETER(FVector2f, TextureSizeInverse)
+	SHADER_PARAMETER(FVector2f, CopyDestinationResolution)
+	SHADER_PARAMETER(float, MaxDistance)
+	SHADER_PARAMETER_RDG_TEXTURE(Texture2D, PrimaryTexture)
+	SHADER_PARAMETER_RDG_TEXTURE(Texture2D, SecondaryTexture)
+	SHADER_PARAMETER_RDG_TEXTURE(Texture2D<uint>, SeedTexture)
+	SHADER_PARAMETER_RDG_TEXTURE(Texture2D<uint>, SeedStencilTexture)
+
+	RENDER_TARGET_BINDING_SLOTS()
+END_SHADER_PARAMETER_STRUCT()
+
+BEGIN_SHADER_PARAMETER_STRUCT(FJumpFloodCopyGroupsParams,)
+	SHADER_PARAMETER_STRUCT_REF(FViewUniformShaderParameters, View)
+	SHADER_PARAMETER_STRUCT_INCLUDE(FSceneTextureShaderParameters, SceneTextures)
 
+	SHADER_PARAMETER(FVector2f, ViewportMin)
+	SHADER_PARAMETER(FVector2f, TextureSize)
+	SHADER_PARAMETER(FVector2f, TextureSizeInverse)
 	SHADER_PARAMETER(FVector2f, CopyDestinationResolution)
+	SHADER_PARAMETER(float, MaxDistance)
+
+	SHADER_PARAMETER(uint32, GroupMode)
+	SHADER_PARAMETER_RDG_TEXTURE(Texture2D<uint4>, GroupSeedTexture)
 
 	RENDER_TARGET_BINDING_SLOTS()
 END_SHADER_PARAMETER_STRUCT()
 
+class FJumpFloodPackedSeedDim : SHADER_PERMUTATION_BOOL("JFA_PACKED_SEED");
+class FJumpFloodPayloadDim : SHADER_PERMUTATION_BOOL("JFA_PAYLOAD");
+class FJumpFloodNativeScaleDim : SHADER_PERMUTATION_BOOL("JFA_NATIVE_SCALE");
+class FJumpFloodSeedCrossDim : SHADER_PERMUTATION_BOOL("JFA_SEED_CROSS");
+class FJumpFloodGroupsDim : SHADER_PERMUTATION_BOOL("JFA_GROUPS");
+
+//  Packed seeds carry nothing but the seed between passes, so only packed shaders that resolve or write a seed's stencil have a
+//  payload to leave out. The rest are only compiled, and always selected, with the payload permutation set
+static bool GetPayloadPermutation(bool bPayload, bool bPackedSeeds, bool bUsesPayload)
+{
+	return bPayload || (bPackedSeeds && !bUsesPayload);
+}
+
 class FJumpFloodSeedPassPS : public FGlobalShader
 {
 	DECLARE_EXPORTED_SHADER_TYPE(FJumpFloodSeedPassPS, Global, );
-	using FParameters = FJumpFloodPassParams;
+	using FParameters = FJumpFloodSeedPassParams;
+	using FPermutationDomain = TShaderPermutationDomain<FJumpFloodPackedSeedDim, FJumpFloodPayloadDim, FJumpFloodNativeScaleDim, FJumpFloodSeedCrossDim>;
 	SHADER_USE_PARAMETER_STRUCT(FJumpFloodSeedPassPS, FGlobalShader);
+
+	static bool ShouldCompilePermutation(const FGlobalShaderPermutationParameters& Parameters)
+	{
+		const FPermutationDomain PermutationVector(Parameters.PermutationId);
+		const bool bPayload = PermutationVector.Get<FJumpFloodPayloadDim>();
+		return GetPayloadPermutation(bPayload, PermutationVector.Get<FJumpFloodPackedSeedDim>(), false) == bPayload;
+	}
+
+	static void ModifyCompilationEnvironment(const FGlobalShaderPermutationParameters& Parameters, FShaderCompilerEnvironment& OutEnvironment)
+	{
+		FGlobalShader::ModifyCompilationEnvironment(Parameters, OutEnvironment);
+
+		if (FPermutationDomain(Parameters.PermutationId).Get<FJumpFloodPackedSeedDim>())
+		{
+			OutEnvironment.SetRenderTargetOutputFormat(0, PF_R32_UINT);
+		}
+	}
 };
 
 IMPLEMENT_SHADER_TYPE(, FJumpFloodSeedPassPS, TEXT("/Plugin/JumpFloodPass/Private/JumpFloodPass.usf"), TEXT("SeedPS"), SF_Pixel);
@@ -50,200 +456,3578 @@ IMPLEMENT_SHADER_TYPE(, FJumpFloodSeedPassPS, TEXT("/Plugin/JumpFloodPass/Privat
 class FJumpFloodFloodPassPS : public FGlobalShader
 {
 	DECLARE_EXPORTED_SHADER_TYPE(FJumpFloodFloodPassPS, Global, );
-	using FParameters = FJumpFloodPassParams;
+	using FParameters = FJumpFloodFloodPassParams;
+	using FPermutationDomain = TShaderPermutationDomain<FJumpFloodPackedSeedDim, FJumpFloodPayloadDim>;
 	SHADER_USE_PARAMETER_STRUCT(FJumpFloodFloodPassPS, FGlobalShader);
+
+	static bool ShouldCompilePermutation(const FGlobalShaderPermutationParameters& Parameters)
+	{
+		const FPermutationDomain PermutationVector(Parameters.PermutationId);
+		const bool bPayload = PermutationVector.Get<FJumpFloodPayloadDim>();
+		return GetPayloadPermutation(bPayload, PermutationVector.Get<FJumpFloodPackedSeedDim>(), false) == bPayload;
+	}
+
+	static void ModifyCompilationEnvironment(const FGlobalShaderPermutationParameters& Parameters, FShaderCompilerEnvironment& OutEnvironment)
+	{
+		FGlobalShader::ModifyCompilationEnvironment(Parameters, OutEnvironment);
+
+		if (FPermutationDomain(Parameters.PermutationId).Get<FJumpFloodPackedSeedDim>())
+		{
+			OutEnvironment.SetRenderTargetOutputFormat(0, PF_R32_UINT);
+		}
+	}
 };
 
 IMPLEMENT_SHADER_TYPE(, FJumpFloodFloodPassPS, TEXT("/Plugin/JumpFloodPass/Private/JumpFloodPass.usf"), TEXT("FloodPS"), SF_Pixel);
 
+//  Last flood step, which resolves the field rather than writing the next intermediate
+class FJumpFloodFloodResolvePS : public FGlobalShader
+{
+	DECLARE_EXPORTED_SHADER_TYPE(FJumpFloodFloodResolvePS, Global, );
+	using FParameters = FJumpFloodFloodResolvePassParams;
+	using FPermutationDomain = TShaderPermutationDomain<FJumpFloodPackedSeedDim, FJumpFloodPayloadDim>;
+	SHADER_USE_PARAMETER_STRUCT(FJumpFloodFloodResolvePS, FGlobalShader);
+
+	static void ModifyCompilationEnvironment(const FGlobalShaderPermutationParameters& Parameters, FShaderCompilerEnvironment& OutEnvironment)
+	{
+		FGlobalShader::ModifyCompilationEnvironment(Parameters, OutEnvironment);
+		OutEnvironment.SetDefine(TEXT("JFA_RESOLVE_OUTPUT"), 1);
+	}
+};
+
+IMPLEMENT_SHADER_TYPE(, FJumpFloodFloodResolvePS, TEXT("/Plugin/JumpFloodPass/Private/JumpFloodPass.usf"), TEXT("FloodPS"), SF_Pixel);
+
 class FJumpFloodCopyPassPS : public FGlobalShader
 {
 	DECLARE_GLOBAL_SHADER(FJumpFloodCopyPassPS);
-	using FParameters = FJumpFloodPassParams;
+	using FParameters = FJumpFloodCopyPassParams;
+	using FPermutationDomain = TShaderPermutationDomain<FJumpFloodPackedSeedDim, FJumpFloodPayloadDim, FJumpFloodNativeScaleDim>;
 	SHADER_USE_PARAMETER_STRUCT(FJumpFloodCopyPassPS, FGlobalShader);
 };
 
 IMPLEMENT_SHADER_TYPE(, FJumpFloodCopyPassPS, TEXT("/Plugin/JumpFloodPass/Private/JumpFloodPass.usf"), TEXT("CopyPS"), SF_Pixel);
 
-bool FJumpFloodPassSceneViewExtension::IsActiveThisFrame_Internal(const FSceneViewExtensionContext& Context) const
+class FJumpFloodCopyGroupsPS : public FGlobalShader
 {
-	return UJumpFloodPassSettings::IsEnabled()
-		&& IsValid(PrimaryRenderTarget)
-		&& IsValid(SecondaryRenderTarget);
-}
+	DECLARE_GLOBAL_SHADER(FJumpFloodCopyGroupsPS);
+	using FParameters = FJumpFloodCopyGroupsParams;
+	using FPermutationDomain = TShaderPermutationDomain<FJumpFloodPayloadDim, FJumpFloodNativeScaleDim>;
+	SHADER_USE_PARAMETER_STRUCT(FJumpFloodCopyGroupsPS, FGlobalShader);
 
-void FJumpFloodPassSceneViewExtension::SetupView(FSceneViewFamily& InViewFamily, FSceneView& InView)
-{
-	FIntRect ViewRect = InView.UnconstrainedViewRect;
+	static bool ShouldCompilePermutation(const FGlobalShaderPermutationParameters& Parameters)
+	{
+		return IsFeatureLevelSupported(Parameters.Platform, ERHIFeatureLevel::SM5);
+	}
 
-	const ISceneViewFamilyScreenPercentage* ScreenPercentageInterface = InViewFamily.GetScreenPercentageInterface();
-	if (ScreenPercentageInterface)
+	static void ModifyCompilationEnvironment(const FGlobalShaderPermutationParameters& Parameters, FShaderCompilerEnvironment& OutEnvironment)
 	{
-		DynamicRenderScaling::TMap<float> UpperBounds = ScreenPercentageInterface->GetResolutionFractionsUpperBound();
-		const float ScreenPercentage = UpperBounds[GDynamicPrimaryResolutionFraction] * InViewFamily.SecondaryViewFraction;
+		FGlobalShader::ModifyCompilationEnvironment(Parameters, OutEnvironment);
+		OutEnvironment.SetDefine(TEXT("JFA_PACKED_SEED"), 1);
+		OutEnvironment.SetDefine(TEXT("JFA_GROUPS"), 1);
+	}
+};
 
-		ViewRect = ViewRect.Scale(ScreenPercentage);
-		FIntPoint ViewSize { ViewRect.Width(), ViewRect.Height() };
+IMPLEMENT_SHADER_TYPE(, FJumpFloodCopyGroupsPS, TEXT("/Plugin/JumpFloodPass/Private/JumpFloodPass.usf"), TEXT("CopyGroupsPS"), SF_Pixel);
 
-		if (PrimaryRenderTarget->GetSurfaceWidth() != ViewSize.X || PrimaryRenderTarget->GetSurfaceHeight() != ViewSize.Y)
-		{
-			PrimaryRenderTarget->InitAutoFormat(ViewSize.X, ViewSize.Y);
-			SecondaryRenderTarget->InitAutoFormat(ViewSize.X, ViewSize.Y);
+//  Tiles a compute flood step is dispatched over indirectly, when it isn't dispatched over the whole view
+BEGIN_SHADER_PARAMETER_STRUCT(FJumpFloodTileListParams,)
+	SHADER_PARAMETER_RDG_BUFFER_SRV(StructuredBuffer<uint>, TileList)
+	RDG_BUFFER_ACCESS(IndirectArgs, ERHIAccess::IndirectArgs)
+END_SHADER_PARAMETER_STRUCT()
 
-			bShouldRecreatePooledRenderTargets = true;
-		}
-	}
-}
+BEGIN_SHADER_PARAMETER_STRUCT(FJumpFloodFloodComputeParams,)
+	SHADER_PARAMETER(FVector2f, TextureSize)
+	SHADER_PARAMETER_STRUCT_INCLUDE(FJumpFloodFloodReadParams, Flood)
+	SHADER_PARAMETER(float, FloodStepSize)
+	SHADER_PARAMETER(float, SeedSpaceScale)
 
-void FJumpFloodPassSceneViewExtension::PostRenderBasePassDeferred_RenderThread(FRDGBuilder& GraphBuilder, FSceneView& InView, const FRenderTargetBindingSlots& RenderTargets, TRDGUniformBufferRef<FSceneTextureUniformParameters> SceneTextures)
-{
-	checkSlow(InView.bIsViewInfo);
-	const FViewInfo& ViewInfo = static_cast<const FViewInfo&>(InView);
+	SHADER_PARAMETER_RDG_TEXTURE_UAV(RWTexture2D<float4>, PrimaryOutputTexture)
+	SHADER_PARAMETER_RDG_TEXTURE_UAV(RWTexture2D<float4>, SecondaryOutputTexture)
+	SHADER_PARAMETER_RDG_TEXTURE_UAV(RWTexture2D<uint>, SeedOutputTexture)
 
-	FSceneViewExtensionBase::PostRenderBasePassDeferred_RenderThread(GraphBuilder, InView, RenderTargets, SceneTextures);
+	SHADER_PARAMETER_STRUCT_INCLUDE(FJumpFloodTileListParams, Tiles)
+END_SHADER_PARAMETER_STRUCT()
 
-	if (!IsActiveThisFrame_Internal(FSceneViewExtensionContext{}))
-	{
-		return;
-	}
+BEGIN_SHADER_PARAMETER_STRUCT(FJumpFloodFloodResolveComputeParams,)
+	SHADER_PARAMETER(FVector2f, TextureSize)
+	SHADER_PARAMETER_STRUCT_INCLUDE(FJumpFloodFloodReadParams, Flood)
+	SHADER_PARAMETER(float, FloodStepSize)
+	SHADER_PARAMETER(float, SeedSpaceScale)
+	SHADER_PARAMETER_STRUCT_INCLUDE(FJumpFloodResolveStepParams, Resolve)
 
-	static const auto CVar = IConsoleManager::Get().FindTConsoleVariableDataFloat(TEXT("r.JumpFloodPass.RenderScale"));
-	float RenderScale = CVar->GetValueOnRenderThread() > 0.0f ? CVar->GetValueOnRenderThread() : 1.0f;
+	SHADER_PARAMETER_RDG_TEXTURE_UAV(RWTexture2D<float4>, PrimaryOutputTexture)
+	SHADER_PARAMETER_RDG_TEXTURE_UAV(RWTexture2D<float4>, SecondaryOutputTexture)
 
-	const FGlobalShaderMap* GlobalShaderMap = GetGlobalShaderMap(GMaxRHIFeatureLevel);
+	SHADER_PARAMETER_STRUCT_INCLUDE(FJumpFloodTileListParams, Tiles)
+END_SHADER_PARAMETER_STRUCT()
 
-	RDG_EVENT_SCOPE(GraphBuilder, "JumpFlood");
+//  The tile pass runs a fixed set of steps, so it has no step size or seed space of its own
+BEGIN_SHADER_PARAMETER_STRUCT(FJumpFloodFloodTileComputeParams,)
+	SHADER_PARAMETER(FVector2f, TextureSize)
+	SHADER_PARAMETER_STRUCT_INCLUDE(FJumpFloodFloodReadParams, Flood)
 
-	if (bShouldRecreatePooledRenderTargets)
-	{
-		CreatePooledRenderTargets_RenderThread();
-	}
+	SHADER_PARAMETER_RDG_TEXTURE_UAV(RWTexture2D<float4>, PrimaryOutputTexture)
+	SHADER_PARAMETER_RDG_TEXTURE_UAV(RWTexture2D<float4>, SecondaryOutputTexture)
+	SHADER_PARAMETER_RDG_TEXTURE_UAV(RWTexture2D<uint>, SeedOutputTexture)
 
-	FRDGTextureRef PrimaryRenderTargetTexture = GraphBuilder.RegisterExternalTexture(PooledPrimaryRenderTarget, TEXT("JumpFloodTarget_0"));
-	FRDGTextureRef SecondaryRenderTargetTexture = GraphBuilder.RegisterExternalTexture(PooledSecondaryRenderTarget, TEXT("JumpFloodTarget_1"));
-	const FIntRect RenderViewport = FIntRect(0, 0, PrimaryRenderTargetTexture->Desc.Extent.X, PrimaryRenderTargetTexture->Desc.Extent.Y);
+	SHADER_PARAMETER_STRUCT_INCLUDE(FJumpFloodTileListParams, Tiles)
+END_SHADER_PARAMETER_STRUCT()
 
-	FRDGTextureDesc IntermediateTargetDesc = PrimaryRenderTargetTexture->Desc;
-	IntermediateTargetDesc.ClearValue = FClearValueBinding::Transparent;
-	IntermediateTargetDesc.Extent =
-		FIntPoint {
-			(int32) ((float) IntermediateTargetDesc.Extent.X * RenderScale),
-			(int32) ((float) IntermediateTargetDesc.Extent.Y * RenderScale) };
+BEGIN_SHADER_PARAMETER_STRUCT(FJumpFloodFloodTileResolveComputeParams,)
+	SHADER_PARAMETER(FVector2f, TextureSize)
+	SHADER_PARAMETER_STRUCT_INCLUDE(FJumpFloodFloodReadParams, Flood)
+	SHADER_PARAMETER_STRUCT_INCLUDE(FJumpFloodResolveStepParams, Resolve)
 
-	const FIntRect IntermediateViewport = FIntRect(0, 0, IntermediateTargetDesc.Extent.X, IntermediateTargetDesc.Extent.Y);
+	SHADER_PARAMETER_RDG_TEXTURE_UAV(RWTexture2D<float4>, PrimaryOutputTexture)
+	SHADER_PARAMETER_RDG_TEXTURE_UAV(RWTexture2D<float4>, SecondaryOutputTexture)
 
-	FRDGTextureRef PrimaryTextures[] = {
-		GraphBuilder.CreateTexture(IntermediateTargetDesc, TEXT("JumpFloodIntermediateTarget_0_0")),
-		GraphBuilder.CreateTexture(IntermediateTargetDesc, TEXT("JumpFloodIntermediateTarget_0_1")),
-	};
+	SHADER_PARAMETER_STRUCT_INCLUDE(FJumpFloodTileListParams, Tiles)
+END_SHADER_PARAMETER_STRUCT()
 
-	FRDGTextureRef SecondaryTextures[] = {
-		GraphBuilder.CreateTexture(IntermediateTargetDesc, TEXT("JumpFloodIntermediateTarget_1_0")),
-		GraphBuilder.CreateTexture(IntermediateTargetDesc, TEXT("JumpFloodIntermediateTarget_1_1")),
-	};
+class FJumpFloodTileListDim : SHADER_PERMUTATION_BOOL("JFA_TILE_LIST");
 
-	int32 ReadIndex  = 0;
-	int32 WriteIndex = 1;
+class FJumpFloodComputeShader : public FGlobalShader
+{
+public:
+	using FPermutationDomain = TShaderPermutationDomain<FJumpFloodPackedSeedDim, FJumpFloodTileListDim>;
 
-	//  Init Pass
+	FJumpFloodComputeShader() = default;
+	FJumpFloodComputeShader(const ShaderMetaType::CompiledShaderInitializerType& Initializer)
+		: FGlobalShader(Initializer)
 	{
-		FJumpFloodSeedPassPS::FParameters* Parameters = GraphBuilder.AllocParameters<FJumpFloodSeedPassPS::FParameters>();
-		Parameters->TextureSize = PrimaryTextures[WriteIndex]->Desc.Extent;
-		Parameters->TextureSizeInverse = FVector2f(1.0f, 1.0f) / Parameters->TextureSize;
-		Parameters->ViewportSize = RenderViewport.Size();
-		Parameters->View = InView.ViewUniformBuffer;
-		Parameters->SceneTextures = CreateSceneTextureShaderParameters(GraphBuilder, ViewInfo.GetSceneTexturesChecked(), InView.GetFeatureLevel(), ESceneTextureSetupMode::All);
-
-		// We're going to also clear the render target
-		Parameters->RenderTargets[0] = FRenderTargetBinding(PrimaryTextures[WriteIndex], ERenderTargetLoadAction::EClear);
-		Parameters->RenderTargets[1] = FRenderTargetBinding(SecondaryTextures[WriteIndex], ERenderTargetLoadAction::EClear);
+	}
 
-		TShaderMapRef<FJumpFloodSeedPassPS> PixelShader(GlobalShaderMap);
-		FPixelShaderUtils::AddFullscreenPass(GraphBuilder, GlobalShaderMap, FRDGEventName(TEXT("JumpFlood - Seed")), PixelShader, Parameters, IntermediateViewport);
+	static bool ShouldCompilePermutation(const FGlobalShaderPermutationParameters& Parameters)
+	{
+		return IsFeatureLevelSupported(Parameters.Platform, ERHIFeatureLevel::SM5);
 	}
 
-	//  Flood Passes
+	static void ModifyCompilationEnvironment(const FGlobalShaderPermutationParameters& Parameters, FShaderCompilerEnvironment& OutEnvironment)
 	{
-		float LargestSide = FMath::Max(IntermediateViewport.Width(), IntermediateViewport.Height());
-		float LargestSideInverse = 1.0f / LargestSide;
+		FGlobalShader::ModifyCompilationEnvironment(Parameters, OutEnvironment);
+		OutEnvironment.SetDefine(TEXT("THREADGROUP_SIZE"), JumpFloodTileSize);
+	}
+};
 
-		//Adding a 1-step pass before full flood Reduces error rate
-		Swap(ReadIndex, WriteIndex);
-		AddFloodPass_RenderThread(
-			GraphBuilder,
-			GlobalShaderMap,
-			ViewInfo,
-			IntermediateViewport,
-			PrimaryTextures[ReadIndex],
-			PrimaryTextures[WriteIndex],
-			SecondaryTextures[ReadIndex],
-			SecondaryTextures[WriteIndex],
-			0,
-			LargestSideInverse);
-			
-		int FloodPassCount = FMath::Log2(LargestSide);
-		for (int FloodExponent = FloodPassCount; FloodExponent > -1 ; FloodExponent -= 1)
-		{
-			Swap(ReadIndex, WriteIndex);
-			AddFloodPass_RenderThread(
-				GraphBuilder,
-				GlobalShaderMap,
-				ViewInfo,
-				IntermediateViewport,
-				PrimaryTextures[ReadIndex],
-				PrimaryTextures[WriteIndex],
-				SecondaryTextures[ReadIndex],
-				SecondaryTextures[WriteIndex],
-				FloodExponent,
-				LargestSideInverse);
-		}
+class FJumpFloodFloodPassCS : public FJumpFloodComputeShader
+{
+	DECLARE_GLOBAL_SHADER(FJumpFloodFloodPassCS);
+	using FParameters = FJumpFloodFloodComputeParams;
+	using FPermutationDomain = TShaderPermutationDomain<FJumpFloodPackedSeedDim, FJumpFloodTileListDim, FJumpFloodPayloadDim>;
+	SHADER_USE_PARAMETER_STRUCT(FJumpFloodFloodPassCS, FJumpFloodComputeShader);
+
+	static bool ShouldCompilePermutation(const FGlobalShaderPermutationParameters& Parameters)
+	{
+		const FPermutationDomain PermutationVector(Parameters.PermutationId);
+		const bool bPayload = PermutationVector.Get<FJumpFloodPayloadDim>();
+		return FJumpFloodComputeShader::ShouldCompilePermutation(Parameters)
+			&& GetPayloadPermutation(bPayload, PermutationVector.Get<FJumpFloodPackedSeedDim>(), false) == bPayload;
 	}
+};
 
-	//  Final stretched copy pass
+IMPLEMENT_SHADER_TYPE(, FJumpFloodFloodPassCS, TEXT("/Plugin/JumpFloodPass/Private/JumpFloodPass.usf"), TEXT("FloodCS"), SF_Compute);
+
+class FJumpFloodFloodResolveCS : public FJumpFloodComputeShader
+{
+	DECLARE_GLOBAL_SHADER(FJumpFloodFloodResolveCS);
+	using FParameters = FJumpFloodFloodResolveComputeParams;
+	using FPermutationDomain = TShaderPermutationDomain<FJumpFloodPackedSeedDim, FJumpFloodTileListDim, FJumpFloodPayloadDim>;
+	SHADER_USE_PARAMETER_STRUCT(FJumpFloodFloodResolveCS, FJumpFloodComputeShader);
+
+	static void ModifyCompilationEnvironment(const FGlobalShaderPermutationParameters& Parameters, FShaderCompilerEnvironment& OutEnvironment)
 	{
-		FJumpFloodCopyPassPS::FParameters* Parameters = GraphBuilder.AllocParameters<FJumpFloodCopyPassPS::FParameters>();
-		Parameters->PrimaryTexture = PrimaryTextures[WriteIndex];
-		Parameters->SecondaryTexture = SecondaryTextures[WriteIndex];
-		Parameters->CopyDestinationResolution = RenderViewport.Size();
-		Parameters->TextureSize = IntermediateTargetDesc.Extent;
-		Parameters->TextureSizeInverse = FVector2f(1.0f, 1.0f) / IntermediateTargetDesc.Extent;
-		Parameters->View = InView.ViewUniformBuffer;
-		Parameters->SceneTextures = CreateSceneTextureShaderParameters(GraphBuilder, ViewInfo.GetSceneTexturesChecked(), InView.GetFeatureLevel(), ESceneTextureSetupMode::All);
+		FJumpFloodComputeShader::ModifyCompilationEnvironment(Parameters, OutEnvironment);
+		OutEnvironment.SetDefine(TEXT("JFA_RESOLVE_OUTPUT"), 1);
+	}
+};
+
+IMPLEMENT_SHADER_TYPE(, FJumpFloodFloodResolveCS, TEXT("/Plugin/JumpFloodPass/Private/JumpFloodPass.usf"), TEXT("FloodCS"), SF_Compute);
 
-		Parameters->RenderTargets[0] = FRenderTargetBinding(PrimaryRenderTargetTexture, ERenderTargetLoadAction::EClear);
-		Parameters->RenderTargets[1] = FRenderTargetBinding(SecondaryRenderTargetTexture, ERenderTargetLoadAction::EClear);
+class FJumpFloodFloodTilePassCS : public FJumpFloodComputeShader
+{
+	DECLARE_GLOBAL_SHADER(FJumpFloodFloodTilePassCS);
+	using FParameters = FJumpFloodFloodTileComputeParams;
+	using FPermutationDomain = TShaderPermutationDomain<FJumpFloodPackedSeedDim, FJumpFloodTileListDim, FJumpFloodPayloadDim>;
+	SHADER_USE_PARAMETER_STRUCT(FJumpFloodFloodTilePassCS, FJumpFloodComputeShader);
 
-		TShaderMapRef<FJumpFloodCopyPassPS> PixelShader(GlobalShaderMap);
-		FPixelShaderUtils::AddFullscreenPass(GraphBuilder, GlobalShaderMap, FRDGEventName(TEXT("JumpFlood - Resolve")), PixelShader, Parameters, RenderViewport);
+	static bool ShouldCompilePermutation(const FGlobalShaderPermutationParameters& Parameters)
+	{
+		const FPermutationDomain PermutationVector(Parameters.PermutationId);
+		const bool bPayload = PermutationVector.Get<FJumpFloodPayloadDim>();
+		return FJumpFloodComputeShader::ShouldCompilePermutation(Parameters)
+			&& GetPayloadPermutation(bPayload, PermutationVector.Get<FJumpFloodPackedSeedDim>(), false) == bPayload;
 	}
-}
+};
 
-void FJumpFloodPassSceneViewExtension::AddFloodPass_RenderThread(
-	FRDGBuilder& GraphBuilder,
+IMPLEMENT_SHADER_TYPE(, FJumpFloodFloodTilePassCS, TEXT("/Plugin/JumpFloodPass/Private/JumpFloodPass.usf"), TEXT("FloodTileCS"), SF_Compute);
+
+class FJumpFloodFloodTileResolveCS : public FJumpFloodComputeShader
+{
+	DECLARE_GLOBAL_SHADER(FJumpFloodFloodTileResolveCS);
+	using FParameters = FJumpFloodFloodTileResolveComputeParams;
+	using FPermutationDomain = TShaderPermutationDomain<FJumpFloodPackedSeedDim, FJumpFloodTileListDim, FJumpFloodPayloadDim>;
+	SHADER_USE_PARAMETER_STRUCT(FJumpFloodFloodTileResolveCS, FJumpFloodComputeShader);
+
+	static void ModifyCompilationEnvironment(const FGlobalShaderPermutationParameters& Parameters, FShaderCompilerEnvironment& OutEnvironment)
+	{
+		FJumpFloodComputeShader::ModifyCompilationEnvironment(Parameters, OutEnvironment);
+		OutEnvironment.SetDefine(TEXT("JFA_RESOLVE_OUTPUT"), 1);
+	}
+};
+
+IMPLEMENT_SHADER_TYPE(, FJumpFloodFloodTileResolveCS, TEXT("/Plugin/JumpFloodPass/Private/JumpFloodPass.usf"), TEXT("FloodTileCS"), SF_Compute);
+
+//  The hierarchical and exact floods only exist for packed seeds
+class FJumpFloodPackedSeedShader : public FJumpFloodComputeShader
+{
+public:
+	using FPermutationDomain = FShaderPermutationNone;
+
+	FJumpFloodPackedSeedShader() = default;
+	FJumpFloodPackedSeedShader(const ShaderMetaType::CompiledShaderInitializerType& Initializer)
+		: FJumpFloodComputeShader(Initializer)
+	{
+	}
+
+	static void ModifyCompilationEnvironment(const FGlobalShaderPermutationParameters& Parameters, FShaderCompilerEnvironment& OutEnvironment)
+	{
+		FJumpFloodComputeShader::ModifyCompilationEnvironment(Parameters, OutEnvironment);
+		OutEnvironment.SetDefine(TEXT("JFA_PACKED_SEED"), 1);
+	}
+};
+
+BEGIN_SHADER_PARAMETER_STRUCT(FJumpFloodReduceSeedsParams,)
+	SHADER_PARAMETER(FVector2f, TextureSize)
+	SHADER_PARAMETER(float, SeedSpaceScale)
+	SHADER_PARAMETER(float, ViewSplit)
+
+	SHADER_PARAMETER_RDG_TEXTURE(Texture2D<uint>, SeedTexture)
+	SHADER_PARAMETER_RDG_TEXTURE_UAV(RWTexture2D<uint>, SeedOutputTexture)
+END_SHADER_PARAMETER_STRUCT()
+
+class FJumpFloodReduceSeedsCS : public FJumpFloodPackedSeedShader
+{
+	DECLARE_GLOBAL_SHADER(FJumpFloodReduceSeedsCS);
+	using FParameters = FJumpFloodReduceSeedsParams;
+	SHADER_USE_PARAMETER_STRUCT(FJumpFloodReduceSeedsCS, FJumpFloodPackedSeedShader);
+};
+
+IMPLEMENT_SHADER_TYPE(, FJumpFloodReduceSeedsCS, TEXT("/Plugin/JumpFloodPass/Private/JumpFloodPass.usf"), TEXT("ReduceSeedsCS"), SF_Compute);
+
+BEGIN_SHADER_PARAMETER_STRUCT(FJumpFloodUpsampleSeedsParams,)
+	SHADER_PARAMETER(FVector2f, TextureSize)
+	SHADER_PARAMETER(float, SeedSpaceScale)
+	SHADER_PARAMETER(float, ViewSplit)
+
+	SHADER_PARAMETER_RDG_TEXTURE(Texture2D<uint>, SeedTexture)
+	SHADER_PARAMETER_RDG_TEXTURE(Texture2D<uint>, CoarseSeedTexture)
+	SHADER_PARAMETER_RDG_TEXTURE_UAV(RWTexture2D<uint>, SeedOutputTexture)
+END_SHADER_PARAMETER_STRUCT()
+
+class FJumpFloodUpsampleSeedsCS : public FJumpFloodPackedSeedShader
+{
+	DECLARE_GLOBAL_SHADER(FJumpFloodUpsampleSeedsCS);
+	using FParameters = FJumpFloodUpsampleSeedsParams;
+	SHADER_USE_PARAMETER_STRUCT(FJumpFloodUpsampleSeedsCS, FJumpFloodPackedSeedShader);
+};
+
+IMPLEMENT_SHADER_TYPE(, FJumpFloodUpsampleSeedsCS, TEXT("/Plugin/JumpFloodPass/Private/JumpFloodPass.usf"), TEXT("UpsampleSeedsCS"), SF_Compute);
+
+BEGIN_SHADER_PARAMETER_STRUCT(FJumpFloodExactParams,)
+	SHADER_PARAMETER(FVector2f, TextureSize)
+	SHADER_PARAMETER(float, ViewSplit)
+
+	SHADER_PARAMETER_RDG_TEXTURE(Texture2D<uint>, SeedTexture)
+	SHADER_PARAMETER_RDG_TEXTURE(Texture2D<uint>, ExactLinkTexture)
+	SHADER_PARAMETER_RDG_TEXTURE(Texture2D<uint>, ExactBandTexture)
+	SHADER_PARAMETER_RDG_TEXTURE(Texture2D<uint>, ExactAnchorTexture)
+
+	SHADER_PARAMETER_RDG_TEXTURE_UAV(RWTexture2D<uint>, SeedOutputTexture)
+	SHADER_PARAMETER_RDG_TEXTURE_UAV(RWTexture2D<uint>, ExactLinkOutputTexture)
+	SHADER_PARAMETER_RDG_TEXTURE_UAV(RWTexture2D<uint>, ExactBandOutputTexture)
+	SHADER_PARAMETER_RDG_TEXTURE_UAV(RWTexture2D<uint>, ExactAnchorOutputTexture)
+END_SHADER_PARAMETER_STRUCT()
+
+class FJumpFloodExactRowsCS : public FJumpFloodPackedSeedShader
+{
+	DECLARE_GLOBAL_SHADER(FJumpFloodExactRowsCS);
+	using FParameters = FJumpFloodExactParams;
+	SHADER_USE_PARAMETER_STRUCT(FJumpFloodExactRowsCS, FJumpFloodPackedSeedShader);
+};
+
+IMPLEMENT_SHADER_TYPE(, FJumpFloodExactRowsCS, TEXT("/Plugin/JumpFloodPass/Private/JumpFloodPass.usf"), TEXT("ExactRowsCS"), SF_Compute);
+
+class FJumpFloodExactColumnBandsCS : public FJumpFloodPackedSeedShader
+{
+	DECLARE_GLOBAL_SHADER(FJumpFloodExactColumnBandsCS);
+	using FParameters = FJumpFloodExactParams;
+	SHADER_USE_PARAMETER_STRUCT(FJumpFloodExactColumnBandsCS, FJumpFloodPackedSeedShader);
+};
+
+IMPLEMENT_SHADER_TYPE(, FJumpFloodExactColumnBandsCS, TEXT("/Plugin/JumpFloodPass/Private/JumpFloodPass.usf"), TEXT("ExactColumnBandsCS"), SF_Compute);
+
+class FJumpFloodExactColumnMergeCS : public FJumpFloodPackedSeedShader
+{
+	DECLARE_GLOBAL_SHADER(FJumpFloodExactColumnMergeCS);
+	using FParameters = FJumpFloodExactParams;
+	SHADER_USE_PARAMETER_STRUCT(FJumpFloodExactColumnMergeCS, FJumpFloodPackedSeedShader);
+};
+
+IMPLEMENT_SHADER_TYPE(, FJumpFloodExactColumnMergeCS, TEXT("/Plugin/JumpFloodPass/Private/JumpFloodPass.usf"), TEXT("ExactColumnMergeCS"), SF_Compute);
+
+class FJumpFloodExactNearestCS : public FJumpFloodPackedSeedShader
+{
+	DECLARE_GLOBAL_SHADER(FJumpFloodExactNearestCS);
+	using FParameters = FJumpFloodExactParams;
+	SHADER_USE_PARAMETER_STRUCT(FJumpFloodExactNearestCS, FJumpFloodPackedSeedShader);
+};
+
+IMPLEMENT_SHADER_TYPE(, FJumpFloodExactNearestCS, TEXT("/Plugin/JumpFloodPass/Private/JumpFloodPass.usf"), TEXT("ExactNearestCS"), SF_Compute);
+
+BEGIN_SHADER_PARAMETER_STRUCT(FJumpFloodCaptureSeedDepthParams,)
+	SHADER_PARAMETER_STRUCT_REF(FViewUniformShaderParameters, View)
+	SHADER_PARAMETER_STRUCT_INCLUDE(FSceneTextureShaderParameters, SceneTextures)
+
+	SHADER_PARAMETER(FVector2f, ViewportMin)
+	SHADER_PARAMETER(FVector2f, ViewportSize)
+	SHADER_PARAMETER(FVector2f, TextureSize)
+	SHADER_PARAMETER(FVector2f, TextureSizeInverse)
+
+	SHADER_PARAMETER_RDG_TEXTURE_UAV(RWTexture2D<float>, SeedDeviceZOutputTexture)
+END_SHADER_PARAMETER_STRUCT()
+
+class FJumpFloodCaptureSeedDepthCS : public FJumpFloodPackedSeedShader
+{
+	DECLARE_GLOBAL_SHADER(FJumpFloodCaptureSeedDepthCS);
+	using FParameters = FJumpFloodCaptureSeedDepthParams;
+	SHADER_USE_PARAMETER_STRUCT(FJumpFloodCaptureSeedDepthCS, FJumpFloodPackedSeedShader);
+};
+
+IMPLEMENT_SHADER_TYPE(, FJumpFloodCaptureSeedDepthCS, TEXT("/Plugin/JumpFloodPass/Private/JumpFloodPass.usf"), TEXT("CaptureSeedDepthCS"), SF_Compute);
+
+BEGIN_SHADER_PARAMETER_STRUCT(FJumpFloodReprojectSeedsParams,)
+	SHADER_PARAMETER(FVector2f, TextureSize)
+	SHADER_PARAMETER(FVector2f, TextureSizeInverse)
+	SHADER_PARAMETER(FMatrix44f, SeedClipToClip)
+
+	SHADER_PARAMETER_RDG_TEXTURE(Texture2D<uint>, SeedTexture)
+	SHADER_PARAMETER_RDG_TEXTURE(Texture2D<float>, SeedDeviceZTexture)
+	SHADER_PARAMETER_RDG_TEXTURE_UAV(RWTexture2D<uint>, SeedOutputTexture)
+END_SHADER_PARAMETER_STRUCT()
+
+class FJumpFloodReprojectSeedsCS : public FJumpFloodPackedSeedShader
+{
+	DECLARE_GLOBAL_SHADER(FJumpFloodReprojectSeedsCS);
+	using FParameters = FJumpFloodReprojectSeedsParams;
+	SHADER_USE_PARAMETER_STRUCT(FJumpFloodReprojectSeedsCS, FJumpFloodPackedSeedShader);
+};
+
+IMPLEMENT_SHADER_TYPE(, FJumpFloodReprojectSeedsCS, TEXT("/Plugin/JumpFloodPass/Private/JumpFloodPass.usf"), TEXT("ReprojectSeedsCS"), SF_Compute);
+
+//  Grouped floods carry one packed seed per group, in the channels of a single R32G32B32A32_UINT texture
+class FJumpFloodGroupShader : public FJumpFloodComputeShader
+{
+public:
+	using FPermutationDomain = FShaderPermutationNone;
+
+	FJumpFloodGroupShader() = default;
+	FJumpFloodGroupShader(const ShaderMetaType::CompiledShaderInitializerType& Initializer)
+		: FJumpFloodComputeShader(Initializer)
+	{
+	}
+
+	static void ModifyCompilationEnvironment(const FGlobalShaderPermutationParameters& Parameters, FShaderCompilerEnvironment& OutEnvironment)
+	{
+		FJumpFloodComputeShader::ModifyCompilationEnvironment(Parameters, OutEnvironment);
+		OutEnvironment.SetDefine(TEXT("JFA_PACKED_SEED"), 1);
+		OutEnvironment.SetDefine(TEXT("JFA_GROUPS"), 1);
+	}
+};
+
+BEGIN_SHADER_PARAMETER_STRUCT(FJumpFloodSeedGroupsParams,)
+	SHADER_PARAMETER_STRUCT_REF(FViewUniformShaderParameters, View)
+	SHADER_PARAMETER_STRUCT_INCLUDE(FSceneTextureShaderParameters, SceneTextures)
+
+	SHADER_PARAMETER(FVector2f, ViewportMin)
+	SHADER_PARAMETER(FVector2f, ViewportSize)
+	SHADER_PARAMETER(FVector2f, TextureSize)
+	SHADER_PARAMETER(FVector2f, TextureSizeInverse)
+
+	SHADER_PARAMETER(uint32, GroupMode)
+	SHADER_PARAMETER_RDG_TEXTURE(Texture2D<uint4>, GroupSeedTexture)
+	SHADER_PARAMETER_RDG_TEXTURE_UAV(RWTexture2D<uint4>, GroupSeedOutputTexture)
+END_SHADER_PARAMETER_STRUCT()
+
+class FJumpFloodSeedGroupsCS : public FJumpFloodGroupShader
+{
+	DECLARE_GLOBAL_SHADER(FJumpFloodSeedGroupsCS);
+	using FParameters = FJumpFloodSeedGroupsParams;
+	using FPermutationDomain = TShaderPermutationDomain<FJumpFloodSeedCrossDim>;
+	SHADER_USE_PARAMETER_STRUCT(FJumpFloodSeedGroupsCS, FJumpFloodGroupShader);
+};
+
+IMPLEMENT_SHADER_TYPE(, FJumpFloodSeedGroupsCS, TEXT("/Plugin/JumpFloodPass/Private/JumpFloodPass.usf"), TEXT("SeedGroupsCS"), SF_Compute);
+
+BEGIN_SHADER_PARAMETER_STRUCT(FJumpFloodFloodGroupsParams,)
+	SHADER_PARAMETER(FVector2f, TextureSize)
+	SHADER_PARAMETER(float, FloodStepSize)
+	SHADER_PARAMETER(float, ViewSplit)
+
+	SHADER_PARAMETER_RDG_TEXTURE(Texture2D<uint4>, GroupSeedTexture)
+	SHADER_PARAMETER_RDG_TEXTURE_UAV(RWTexture2D<uint4>, GroupSeedOutputTexture)
+END_SHADER_PARAMETER_STRUCT()
+
+class FJumpFloodFloodGroupsCS : public FJumpFloodGroupShader
+{
+	DECLARE_GLOBAL_SHADER(FJumpFloodFloodGroupsCS);
+	using FParameters = FJumpFloodFloodGroupsParams;
+	SHADER_USE_PARAMETER_STRUCT(FJumpFloodFloodGroupsCS, FJumpFloodGroupShader);
+};
+
+IMPLEMENT_SHADER_TYPE(, FJumpFloodFloodGroupsCS, TEXT("/Plugin/JumpFloodPass/Private/JumpFloodPass.usf"), TEXT("FloodGroupsCS"), SF_Compute);
+
+BEGIN_SHADER_PARAMETER_STRUCT(FJumpFloodResolveGroupsParams,)
+	SHADER_PARAMETER_STRUCT_REF(FViewUniformShaderParameters, View)
+	SHADER_PARAMETER_STRUCT_INCLUDE(FSceneTextureShaderParameters, SceneTextures)
+
+	SHADER_PARAMETER(FVector2f, ViewportMin)
+	SHADER_PARAMETER(FVector2f, ViewportSize)
+	SHADER_PARAMETER(FVector2f, TextureSize)
+	SHADER_PARAMETER(FVector2f, TextureSizeInverse)
+	SHADER_PARAMETER(float, MaxDistance)
+
+	SHADER_PARAMETER(uint32, GroupMode)
+	SHADER_PARAMETER_RDG_TEXTURE(Texture2D<uint4>, GroupSeedTexture)
+
+	SHADER_PARAMETER_RDG_TEXTURE_UAV(RWTexture2D<float4>, PrimaryOutputTexture)
+	SHADER_PARAMETER_RDG_TEXTURE_UAV(RWTexture2D<float4>, SecondaryOutputTexture)
+END_SHADER_PARAMETER_STRUCT()
+
+class FJumpFloodResolveGroupsCS : public FJumpFloodGroupShader
+{
+	DECLARE_GLOBAL_SHADER(FJumpFloodResolveGroupsCS);
+	using FParameters = FJumpFloodResolveGroupsParams;
+	using FPermutationDomain = TShaderPermutationDomain<FJumpFloodPayloadDim>;
+	SHADER_USE_PARAMETER_STRUCT(FJumpFloodResolveGroupsCS, FJumpFloodGroupShader);
+};
+
+IMPLEMENT_SHADER_TYPE(, FJumpFloodResolveGroupsCS, TEXT("/Plugin/JumpFloodPass/Private/JumpFloodPass.usf"), TEXT("ResolveGroupsCS"), SF_Compute);
+
+BEGIN_SHADER_PARAMETER_STRUCT(FJumpFloodSeedSourceParams,)
+	SHADER_PARAMETER_RDG_BUFFER_SRV(StructuredBuffer<FJumpFloodSeedPiece>, SeedPieces)
+
+	SHADER_PARAMETER_RDG_TEXTURE_UAV(RWTexture2D<float4>, PrimaryOutputTexture)
+	SHADER_PARAMETER_RDG_TEXTURE_UAV(RWTexture2D<float4>, SecondaryOutputTexture)
+	SHADER_PARAMETER_RDG_TEXTURE_UAV(RWTexture2D<uint>, SeedOutputTexture)
+	SHADER_PARAMETER_RDG_TEXTURE_UAV(RWTexture2D<uint>, SeedStencilOutputTexture)
+
+	SHADER_PARAMETER(uint32, GroupMode)
+	SHADER_PARAMETER(uint32, SeedGroup)
+	SHADER_PARAMETER_RDG_TEXTURE_UAV(RWTexture2D<uint4>, GroupSeedOutputTexture)
+END_SHADER_PARAMETER_STRUCT()
+
+class FJumpFloodSeedSourceCS : public FJumpFloodComputeShader
+{
+	DECLARE_GLOBAL_SHADER(FJumpFloodSeedSourceCS);
+	using FParameters = FJumpFloodSeedSourceParams;
+	using FPermutationDomain = TShaderPermutationDomain<FJumpFloodPackedSeedDim, FJumpFloodPayloadDim, FJumpFloodGroupsDim>;
+	SHADER_USE_PARAMETER_STRUCT(FJumpFloodSeedSourceCS, FJumpFloodComputeShader);
+
+	//  Grouped seeds are packed, and their group stands in for the stencil
+	static bool ShouldCompilePermutation(const FGlobalShaderPermutationParameters& Parameters)
+	{
+		const FPermutationDomain PermutationVector(Parameters.PermutationId);
+		return FJumpFloodComputeShader::ShouldCompilePermutation(Parameters)
+			&& (!PermutationVector.Get<FJumpFloodGroupsDim>() || (PermutationVector.Get<FJumpFloodPackedSeedDim>() && !PermutationVector.Get<FJumpFloodPayloadDim>()));
+	}
+};
+
+IMPLEMENT_SHADER_TYPE(, FJumpFloodSeedSourceCS, TEXT("/Plugin/JumpFloodPass/Private/JumpFloodPass.usf"), TEXT("SeedSourceCS"), SF_Compute);
+
+BEGIN_SHADER_PARAMETER_STRUCT(FJumpFloodTileClassificationParams,)
+	SHADER_PARAMETER(FVector2f, TextureSize)
+	SHADER_PARAMETER(FUintVector2, TileCount)
+	SHADER_PARAMETER(int32, TileRadius)
+
+	SHADER_PARAMETER_RDG_TEXTURE(Texture2D, PrimaryTexture)
+	SHADER_PARAMETER_RDG_TEXTURE(Texture2D<uint>, SeedTexture)
+	SHADER_PARAMETER_RDG_TEXTURE(Texture2D<uint>, TileMask)
+	SHADER_PARAMETER_RDG_BUFFER_SRV(Buffer<uint>, AnyTile)
+
+	SHADER_PARAMETER_RDG_TEXTURE_UAV(RWTexture2D<uint>, TileMaskOutput)
+	SHADER_PARAMETER_RDG_BUFFER_UAV(RWBuffer<uint>, AnyTileOutput)
+	SHADER_PARAMETER_RDG_BUFFER_UAV(RWBuffer<uint>, TileArgsOutput)
+	SHADER_PARAMETER_RDG_BUFFER_UAV(RWStructuredBuffer<uint>, TileListOutput)
+END_SHADER_PARAMETER_STRUCT()
+
+class FJumpFloodClassifyTilesCS : public FJumpFloodComputeShader
+{
+	DECLARE_GLOBAL_SHADER(FJumpFloodClassifyTilesCS);
+	using FParameters = FJumpFloodTileClassificationParams;
+	using FPermutationDomain = TShaderPermutationDomain<FJumpFloodPackedSeedDim>;
+	SHADER_USE_PARAMETER_STRUCT(FJumpFloodClassifyTilesCS, FJumpFloodComputeShader);
+};
+
+IMPLEMENT_SHADER_TYPE(, FJumpFloodClassifyTilesCS, TEXT("/Plugin/JumpFloodPass/Private/JumpFloodPass.usf"), TEXT("ClassifyTilesCS"), SF_Compute);
+
+class FJumpFloodDilateTilesCS : public FJumpFloodComputeShader
+{
+	DECLARE_GLOBAL_SHADER(FJumpFloodDilateTilesCS);
+	using FParameters = FJumpFloodTileClassificationParams;
+	using FPermutationDomain = FShaderPermutationNone;
+	SHADER_USE_PARAMETER_STRUCT(FJumpFloodDilateTilesCS, FJumpFloodComputeShader);
+};
+
+IMPLEMENT_SHADER_TYPE(, FJumpFloodDilateTilesCS, TEXT("/Plugin/JumpFloodPass/Private/JumpFloodPass.usf"), TEXT("DilateTilesCS"), SF_Compute);
+
+class FJumpFloodBuildTileListCS : public FJumpFloodComputeShader
+{
+	DECLARE_GLOBAL_SHADER(FJumpFloodBuildTileListCS);
+	using FParameters = FJumpFloodTileClassificationParams;
+	using FPermutationDomain = FShaderPermutationNone;
+	SHADER_USE_PARAMETER_STRUCT(FJumpFloodBuildTileListCS, FJumpFloodComputeShader);
+};
+
+IMPLEMENT_SHADER_TYPE(, FJumpFloodBuildTileListCS, TEXT("/Plugin/JumpFloodPass/Private/JumpFloodPass.usf"), TEXT("BuildTileListCS"), SF_Compute);
+
+BEGIN_SHADER_PARAMETER_STRUCT(FJumpFloodTileHashParams,)
+	SHADER_PARAMETER_STRUCT_REF(FViewUniformShaderParameters, View)
+	SHADER_PARAMETER_STRUCT_INCLUDE(FSceneTextureShaderParameters, SceneTextures)
+
+	SHADER_PARAMETER(FVector2f, ViewportMin)
+	SHADER_PARAMETER(FVector2f, ViewportSize)
+	SHADER_PARAMETER(FVector2f, TextureSize)
+	SHADER_PARAMETER(FVector2f, TextureSizeInverse)
+
+	SHADER_PARAMETER_RDG_TEXTURE(Texture2D<uint>, PreviousTileHash)
+
+	SHADER_PARAMETER_RDG_TEXTURE_UAV(RWTexture2D<uint>, TileHashOutput)
+	SHADER_PARAMETER_RDG_TEXTURE_UAV(RWTexture2D<uint>, TileMaskOutput)
+	SHADER_PARAMETER_RDG_BUFFER_UAV(RWBuffer<uint>, AnyTileOutput)
+END_SHADER_PARAMETER_STRUCT()
+
+class FJumpFloodHashTilesCS : public FJumpFloodComputeShader
+{
+	DECLARE_GLOBAL_SHADER(FJumpFloodHashTilesCS);
+	using FParameters = FJumpFloodTileHashParams;
+	using FPermutationDomain = FShaderPermutationNone;
+	SHADER_USE_PARAMETER_STRUCT(FJumpFloodHashTilesCS, FJumpFloodComputeShader);
+};
+
+IMPLEMENT_SHADER_TYPE(, FJumpFloodHashTilesCS, TEXT("/Plugin/JumpFloodPass/Private/JumpFloodPass.usf"), TEXT("HashTilesCS"), SF_Compute);
+
+BEGIN_SHADER_PARAMETER_STRUCT(FJumpFloodFieldQueryParams,)
+	SHADER_PARAMETER(FVector2f, ViewportMin)
+	SHADER_PARAMETER(FVector2f, ViewportSize)
+	SHADER_PARAMETER(uint32, FieldQueryCount)
+
+	SHADER_PARAMETER_RDG_TEXTURE(Texture2D, PrimaryTexture)
+	SHADER_PARAMETER_RDG_TEXTURE(Texture2D, SecondaryTexture)
+	SHADER_PARAMETER_RDG_BUFFER_SRV(StructuredBuffer<FVector2f>, FieldQueryPoints)
+
+	SHADER_PARAMETER_RDG_BUFFER_UAV(RWStructuredBuffer<FVector4f>, FieldQueryOutput)
+END_SHADER_PARAMETER_STRUCT()
+
+class FJumpFloodFieldQueryCS : public FJumpFloodComputeShader
+{
+	DECLARE_GLOBAL_SHADER(FJumpFloodFieldQueryCS);
+	using FParameters = FJumpFloodFieldQueryParams;
+	using FPermutationDomain = FShaderPermutationNone;
+	SHADER_USE_PARAMETER_STRUCT(FJumpFloodFieldQueryCS, FJumpFloodComputeShader);
+};
+
+IMPLEMENT_SHADER_TYPE(, FJumpFloodFieldQueryCS, TEXT("/Plugin/JumpFloodPass/Private/JumpFloodPass.usf"), TEXT("FieldQueryCS"), SF_Compute);
+
+class FJumpFloodTileVS : public FGlobalShader
+{
+	DECLARE_GLOBAL_SHADER(FJumpFloodTileVS);
+	SHADER_USE_PARAMETER_STRUCT(FJumpFloodTileVS, FGlobalShader);
+
+	BEGIN_SHADER_PARAMETER_STRUCT(FParameters,)
+		SHADER_PARAMETER_RDG_BUFFER_SRV(StructuredBuffer<uint>, TileList)
+		SHADER_PARAMETER(FVector2f, TileToOutputScale)
+		SHADER_PARAMETER(FVector2f, CopyDestinationResolution)
+	END_SHADER_PARAMETER_STRUCT()
+
+	static bool ShouldCompilePermutation(const FGlobalShaderPermutationParameters& Parameters)
+	{
+		return IsFeatureLevelSupported(Parameters.Platform, ERHIFeatureLevel::SM5);
+	}
+
+	static void ModifyCompilationEnvironment(const FGlobalShaderPermutationParameters& Parameters, FShaderCompilerEnvironment& OutEnvironment)
+	{
+		FGlobalShader::ModifyCompilationEnvironment(Parameters, OutEnvironment);
+		OutEnvironment.SetDefine(TEXT("THREADGROUP_SIZE"), JumpFloodTileSize);
+	}
+};
+
+IMPLEMENT_SHADER_TYPE(, FJumpFloodTileVS, TEXT("/Plugin/JumpFloodPass/Private/JumpFloodPass.usf"), TEXT("TileVS"), SF_Vertex);
+
+BEGIN_SHADER_PARAMETER_STRUCT(FJumpFloodSeedTileDrawParams,)
+	SHADER_PARAMETER_STRUCT_INCLUDE(FJumpFloodTileVS::FParameters, VS)
+	SHADER_PARAMETER_STRUCT_INCLUDE(FJumpFloodSeedPassParams, PS)
+	RDG_BUFFER_ACCESS(IndirectArgs, ERHIAccess::IndirectArgs)
+END_SHADER_PARAMETER_STRUCT()
+
+BEGIN_SHADER_PARAMETER_STRUCT(FJumpFloodCopyTileDrawParams,)
+	SHADER_PARAMETER_STRUCT_INCLUDE(FJumpFloodTileVS::FParameters, VS)
+	SHADER_PARAMETER_STRUCT_INCLUDE(FJumpFloodCopyPassParams, PS)
+	RDG_BUFFER_ACCESS(IndirectArgs, ERHIAccess::IndirectArgs)
+END_SHADER_PARAMETER_STRUCT()
+
+//  Runs a pixel shader over only the listed tiles, drawing one quad per tile with an indirect draw into OutputViewport
+template<typename TShaderClass, typename TPassParameters>
+static void AddTileDrawPass(
+	FRDGBuilder& GraphBuilder,
+	FRDGEventName&& PassName,
+	const FGlobalShaderMap* GlobalShaderMap,
+	const FIntRect& OutputViewport,
+	const FIntRect& IntermediateViewport,
+	const TShaderRef<TShaderClass>& PixelShader,
+	TPassParameters* Parameters,
+	const FJumpFloodTileList& TileList)
+{
+	TShaderMapRef<FJumpFloodTileVS> VertexShader(GlobalShaderMap);
+
+	Parameters->VS.TileList = TileList.Tiles;
+	Parameters->VS.TileToOutputScale = FVector2f(OutputViewport.Size()) / FVector2f(IntermediateViewport.Size());
+	Parameters->VS.CopyDestinationResolution = OutputViewport.Size();
+	Parameters->IndirectArgs = TileList.IndirectArgs;
+
+	ClearUnusedGraphResources(PixelShader, &Parameters->PS);
+
+	GraphBuilder.AddPass(
+		MoveTemp(PassName),
+		Parameters,
+		ERDGPassFlags::Raster,
+		[Parameters, VertexShader, PixelShader, OutputViewport](FRHICommandList& RHICmdList)
+		{
+			RHICmdList.SetViewport(OutputViewport.Min.X, OutputViewport.Min.Y, 0.0f, OutputViewport.Max.X, OutputViewport.Max.Y, 1.0f);
+
+			FGraphicsPipelineStateInitializer GraphicsPSOInit;
+			RHICmdList.ApplyCachedRenderTargets(GraphicsPSOInit);
+			GraphicsPSOInit.BlendState = TStaticBlendState<>::GetRHI();
+			GraphicsPSOInit.RasterizerState = TStaticRasterizerState<>::GetRHI();
+			GraphicsPSOInit.DepthStencilState = TStaticDepthStencilState<false, CF_Always>::GetRHI();
+			GraphicsPSOInit.BoundShaderState.VertexDeclarationRHI = GEmptyVertexDeclaration.VertexDeclarationRHI;
+			GraphicsPSOInit.BoundShaderState.VertexShaderRHI = VertexShader.GetVertexShader();
+			GraphicsPSOInit.BoundShaderState.PixelShaderRHI = PixelShader.GetPixelShader();
+			GraphicsPSOInit.PrimitiveType = PT_TriangleList;
+			SetGraphicsPipelineState(RHICmdList, GraphicsPSOInit, 0);
+
+			SetShaderParameters(RHICmdList, VertexShader, VertexShader.GetVertexShader(), Parameters->VS);
+			SetShaderParameters(RHICmdList, PixelShader, PixelShader.GetPixelShader(), Parameters->PS);
+
+			RHICmdList.DrawPrimitiveIndirect(Parameters->IndirectArgs->GetIndirectRHICallBuffer(), JumpFloodTileDrawArgsOffset * sizeof(uint32));
+		});
+}
+
+//  Dispatches a flood compute shader over the whole intermediate viewport, or indirectly over just the listed tiles
+template<typename TShaderClass, typename TParameters>
+static void AddFloodComputeDispatch(
+	FRDGBuilder& GraphBuilder,
+	FRDGEventName&& PassName,
+	const TShaderRef<TShaderClass>& ComputeShader,
+	TParameters* Parameters,
+	ERDGPassFlags PassFlags,
+	const FIntRect& IntermediateViewport,
+	const FJumpFloodTileList* TileList)
+{
+	if (TileList)
+	{
+		Parameters->Tiles.TileList = TileList->Tiles;
+		Parameters->Tiles.IndirectArgs = TileList->IndirectArgs;
+		FComputeShaderUtils::AddPass(GraphBuilder, MoveTemp(PassName), PassFlags, ComputeShader, Parameters, TileList->IndirectArgs, JumpFloodTileDispatchArgsOffset * sizeof(uint32));
+	}
+	else
+	{
+		FComputeShaderUtils::AddPass(GraphBuilder, MoveTemp(PassName), PassFlags, ComputeShader, Parameters, FComputeShaderUtils::GetGroupCount(IntermediateViewport.Size(), JumpFloodTileSize));
+	}
+}
+
+//  Binds the intermediates a flood step reads, in whichever layout they are in
+static void SetFloodReadTextures(FJumpFloodFloodReadParams& Parameters, FRDGTextureRef PrimaryReadTexture, FRDGTextureRef SecondaryReadTexture, bool bPackedSeeds)
+{
+	if (bPackedSeeds)
+	{
+		Parameters.SeedTexture = PrimaryReadTexture;
+	}
+	else
+	{
+		Parameters.PrimaryTexture = PrimaryReadTexture;
+		Parameters.SecondaryTexture = SecondaryReadTexture;
+	}
+}
+
+template<typename TParameters>
+static void SetFloodComputeTextures(
+	FRDGBuilder& GraphBuilder,
+	TParameters* Parameters,
+	FRDGTextureRef PrimaryReadTexture,
+	FRDGTextureRef PrimaryWriteTexture,
+	FRDGTextureRef SecondaryReadTexture,
+	FRDGTextureRef SecondaryWriteTexture,
+	bool bPackedSeeds)
+{
+	SetFloodReadTextures(Parameters->Flood, PrimaryReadTexture, SecondaryReadTexture, bPackedSeeds);
+
+	if (bPackedSeeds)
+	{
+		Parameters->SeedOutputTexture = GraphBuilder.CreateUAV(PrimaryWriteTexture);
+	}
+	else
+	{
+		Parameters->PrimaryOutputTexture = GraphBuilder.CreateUAV(PrimaryWriteTexture);
+
+		//  Unpacked intermediates without a payload have no Secondary texture
+		if (SecondaryWriteTexture)
+		{
+			Parameters->SecondaryOutputTexture = GraphBuilder.CreateUAV(SecondaryWriteTexture);
+		}
+	}
+}
+
+//  Binds what the resolving flood step reads of the view and the scene, for intermediates of TextureSize texels
+static void SetResolveStepParameters(
+	FRDGBuilder& GraphBuilder,
+	FJumpFloodResolveStepParams& Parameters,
+	const FViewInfo& ViewInfo,
+	const FJumpFloodResolveOutput& ResolveOutput,
+	const FIntPoint& TextureSize,
+	bool bPackedSeeds)
+{
+	Parameters.View = ViewInfo.ViewUniformBuffer;
+	Parameters.SceneTextures = GetSceneTextureParameters(GraphBuilder, ViewInfo);
+	Parameters.TextureSizeInverse = FVector2f(1.0f, 1.0f) / FVector2f(TextureSize);
+	Parameters.ViewportMin = ResolveOutput.Viewport.Min;
+	Parameters.ViewportSize = ResolveOutput.Viewport.Size();
+	Parameters.MaxDistance = ResolveOutput.MaxDistance;
+
+	if (bPackedSeeds && ResolveOutput.bPayload)
+	{
+		Parameters.SeedStencilTexture = ResolveOutput.SeedStencilTexture ? ResolveOutput.SeedStencilTexture : GSystemTextures.GetZeroUIntDummy(GraphBuilder);
+	}
+}
+
+//  Binds what a compute flood step needs to resolve straight into the field, rather than writing the next intermediate
+template<typename TParameters>
+static void SetFloodComputeResolveOutput(
+	FRDGBuilder& GraphBuilder,
+	TParameters* Parameters,
+	const FJumpFloodResolveOutput& ResolveOutput,
+	FRDGTextureRef PrimaryReadTexture,
+	FRDGTextureRef SecondaryReadTexture,
+	bool bPackedSeeds)
+{
+	SetResolveStepParameters(GraphBuilder, Parameters->Resolve, *ResolveOutput.ViewInfo, ResolveOutput, PrimaryReadTexture->Desc.Extent, bPackedSeeds);
+
+	//  Only the reads follow the intermediates' layout, the resolved field is always written as Primary/Secondary
+	SetFloodReadTextures(Parameters->Flood, PrimaryReadTexture, SecondaryReadTexture, bPackedSeeds);
+	Parameters->PrimaryOutputTexture = GraphBuilder.CreateUAV(ResolveOutput.PrimaryTexture);
+	Parameters->SecondaryOutputTexture = GraphBuilder.CreateUAV(ResolveOutput.SecondaryTexture);
+}
+
+//  Writes a GPU timestamp at this point of the graph
+static void AddTimestampPass(FRDGBuilder& GraphBuilder, FRHIRenderQuery* Query)
+{
+	GraphBuilder.AddPass(RDG_EVENT_NAME("JumpFlood - Timestamp"), ERDGPassFlags::NeverCull, [Query](FRHICommandListImmediate& RHICmdList)
+	{
+		RHICmdList.EndRenderQuery(Query);
+	});
+}
+
+//  Moves one quality setting at a time, cheapest to give up first, towards the middle of the band around the budget
+static void UpdateBudgetDecisions(FJumpFloodBudgetState& State, float CostMs, float BudgetMs)
+{
+	const float MinRenderScaleFraction = FMath::Clamp(CVarJumpFloodBudgetMinRenderScale.GetValueOnRenderThread(), JumpFloodBudgetRenderScaleStep, 1.0f);
+	const int32 MaxFloodPassReduction = FMath::Max(CVarJumpFloodBudgetMaxFloodPassReduction.GetValueOnRenderThread(), 0);
+	const int32 MaxRefinementPassCount = FMath::Max(CVarJumpFloodRefinementPasses.GetValueOnRenderThread(), 0);
+
+	State.MeasuredCostMs = CostMs;
+	State.SmoothedCostMs = State.SmoothedCostMs > 0.0f ? FMath::Lerp(State.SmoothedCostMs, CostMs, JumpFloodBudgetSmoothing) : CostMs;
+
+	//  Limits can change underneath the controller
+	State.RenderScaleFraction = FMath::Clamp(State.RenderScaleFraction, MinRenderScaleFraction, 1.0f);
+	State.FloodPassReduction = FMath::Min(State.FloodPassReduction, MaxFloodPassReduction);
+	State.RefinementPassCount = FMath::Min(State.RefinementPassCount, MaxRefinementPassCount);
+
+	if (State.CooldownFrameCount > 0)
+	{
+		--State.CooldownFrameCount;
+		return;
+	}
+
+	const float Ratio = State.SmoothedCostMs / BudgetMs;
+
+	//  The cost mostly follows the texel count, so the square of the render scale
+	const float TargetRatio = (1.0f + JumpFloodBudgetHeadroom) * 0.5f;
+	const float IdealRenderScaleFraction = FMath::FloorToFloat(State.RenderScaleFraction * FMath::Sqrt(TargetRatio / Ratio) / JumpFloodBudgetRenderScaleStep) * JumpFloodBudgetRenderScaleStep;
+
+	const FJumpFloodBudgetState PreviousState = State;
+	if (Ratio > 1.0f)
+	{
+		if (State.RefinementPassCount > 0)
+		{
+			--State.RefinementPassCount;
+		}
+		else if (State.RenderScaleFraction > MinRenderScaleFraction)
+		{
+			State.RenderScaleFraction = FMath::Max(FMath::Min(IdealRenderScaleFraction, State.RenderScaleFraction - JumpFloodBudgetRenderScaleStep), MinRenderScaleFraction);
+		}
+		else if (State.FloodPassReduction < MaxFloodPassReduction)
+		{
+			++State.FloodPassReduction;
+		}
+	}
+	else if (Ratio < JumpFloodBudgetHeadroom)
+	{
+		if (State.FloodPassReduction > 0)
+		{
+			--State.FloodPassReduction;
+		}
+		else if (State.RenderScaleFraction < 1.0f)
+		{
+			State.RenderScaleFraction = FMath::Min(FMath::Max(IdealRenderScaleFraction, State.RenderScaleFraction + JumpFloodBudgetRenderScaleStep), 1.0f);
+		}
+		else if (State.RefinementPassCount < MaxRefinementPassCount)
+		{
+			++State.RefinementPassCount;
+		}
+	}
+
+	if (State.RenderScaleFraction != PreviousState.RenderScaleFraction
+		|| State.FloodPassReduction != PreviousState.FloodPassReduction
+		|| State.RefinementPassCount != PreviousState.RefinementPassCount)
+	{
+		State.CooldownFrameCount = JumpFloodBudgetCooldownFrames;
+	}
+}
+
+//  Largest flood step of a view's intermediates, as a power of two. Steps of 2^N down to 1 reach 2^(N+1)-1 texels, so a bounded
+//  flood only starts as large as its radius needs
+static int32 GetFloodPassCount(const FIntRect& IntermediateViewport, float MaxDistance, float RenderScale, int32 FloodPassReduction)
+{
+	int32 FloodPassCount = FMath::Log2((float) FMath::Max(IntermediateViewport.Width(), IntermediateViewport.Height()));
+
+	if (MaxDistance > 0.0f)
+	{
+		const float IntermediateMaxDistance = FMath::Max(MaxDistance * RenderScale, 1.0f);
+		FloodPassCount = FMath::Min(FloodPassCount, FMath::CeilToInt(FMath::Log2(IntermediateMaxDistance + 1.0f)) - 1);
+	}
+
+	//  Leaving out the largest steps shortens the reach, but never below the single step every flood has
+	return FMath::Max(FloodPassCount - FloodPassReduction, FMath::Min(FloodPassCount, 0));
+}
+
+//  Camera movement below these moves the field by well under a texel, and is left to the dirty tiles to pick up. Rotation and
+//  projection are compared by matrix element, and the view origin in world units
+static constexpr double JumpFloodHistoryMatrixTolerance = 1.e-5;
+static constexpr double JumpFloodHistoryOriginTolerance = 0.01;
+
+//  The previous resolve is only still valid if it was made from the same view, into the same targets, with the same settings
+static bool IsHistoryReusable(const FJumpFloodHistory& History, const FJumpFloodHistory& Current)
+{
+	return History.TileHash.IsValid()
+		&& History.OutputTexture == Current.OutputTexture
+		&& History.OutputViewport == Current.OutputViewport
+		&& History.IntermediateExtent == Current.IntermediateExtent
+		&& History.MaxDistance == Current.MaxDistance
+		&& History.bPackedSeeds == Current.bPackedSeeds
+		&& History.bExactFlood == Current.bExactFlood
+		&& History.bPayload == Current.bPayload
+		&& History.FloodPassReduction == Current.FloodPassReduction
+		&& History.RefinementPassCount == Current.RefinementPassCount
+		&& History.SeedSourcesRevision == Current.SeedSourcesRevision
+		&& History.ViewMatrix.RemoveTranslation().Equals(Current.ViewMatrix.RemoveTranslation(), JumpFloodHistoryMatrixTolerance)
+		&& History.ViewOrigin.Equals(Current.ViewOrigin, JumpFloodHistoryOriginTolerance)
+		&& History.ProjectionMatrix.Equals(Current.ProjectionMatrix, JumpFloodHistoryMatrixTolerance);
+}
+
+//  Which of the r.JumpFloodPass.ViewTypes bits covers a view, or 0 for views that are never flooded
+static int32 GetViewType(const FSceneView& View)
+{
+	if (View.bIsReflectionCapture || View.bIsVirtualTexture)
+	{
+		return 0;
+	}
+
+	if (View.bIsSceneCapture || View.bIsPlanarReflection)
+	{
+		return JumpFloodViewTypeSceneCapture;
+	}
+
+	return View.Family->EngineShowFlags.Game ? JumpFloodViewTypeGame : JumpFloodViewTypeOther;
+}
+
+static bool IsFloodedViewType(const FSceneView& View)
+{
+	return (CVarJumpFloodViewTypes.GetValueOnAnyThread() & GetViewType(View)) != 0;
+}
+
+bool FJumpFloodPassSceneViewExtension::IsActiveThisFrame_Internal(const FSceneViewExtensionContext& Context) const
+{
+	return UJumpFloodPassSettings::IsEnabled()
+		&& (IsPublishingField() || (IsValid(PrimaryRenderTarget) && IsValid(SecondaryRenderTarget)));
+}
+
+bool FJumpFloodPassSceneViewExtension::IsPublishingField() const
+{
+	return CVarJumpFloodPostProcessInput.GetValueOnAnyThread() > 0 && IsValid(PostProcessMaterial);
+}
+
+void FJumpFloodPassSceneViewExtension::SetupViewFamily(FSceneViewFamily& InViewFamily)
+{
+	FamilyRenderTargetSize = FIntPoint::ZeroValue;
+	FamilyActiveViewRect = FIntRect();
+}
+
+void FJumpFloodPassSceneViewExtension::SetupView(FSceneViewFamily& InViewFamily, FSceneView& InView)
+{
+	//  Views that won't be flooded mustn't grow the render target assets either
+	if (!IsFloodedViewType(InView))
+	{
+		return;
+	}
+
+	FIntRect ViewRect = InView.UnconstrainedViewRect;
+
+	const ISceneViewFamilyScreenPercentage* ScreenPercentageInterface = InViewFamily.GetScreenPercentageInterface();
+	if (ScreenPercentageInterface)
+	{
+		DynamicRenderScaling::TMap<float> UpperBounds = ScreenPercentageInterface->GetResolutionFractionsUpperBound();
+		const float ScreenPercentage = UpperBounds[GDynamicPrimaryResolutionFraction] * InViewFamily.SecondaryViewFraction;
+
+		//  Every view of the family resolves into its own region of the targets, laid out the same way as the scene textures
+		const FIntRect UpperBoundViewRect = ViewRect.Scale(ScreenPercentage);
+		FamilyRenderTargetSize = FamilyRenderTargetSize.ComponentMax(UpperBoundViewRect.Max);
+
+		//  Dynamic resolution renders into less than the upper bound, by a fraction only known approximately this early
+		float ActiveScreenPercentage = ScreenPercentage;
+		if (GEngine)
+		{
+			FDynamicResolutionStateInfos DynamicResolutionInfos;
+			GEngine->GetDynamicResolutionCurrentStateInfos(DynamicResolutionInfos);
+			if (DynamicResolutionInfos.Status == EDynamicResolutionStatus::Enabled || DynamicResolutionInfos.Status == EDynamicResolutionStatus::DebugForceEnabled)
+			{
+				ActiveScreenPercentage = FMath::Min(DynamicResolutionInfos.ResolutionFractionApproximations[GDynamicPrimaryResolutionFraction], UpperBounds[GDynamicPrimaryResolutionFraction]) * InViewFamily.SecondaryViewFraction;
+			}
+		}
+
+		const FIntRect ActiveViewRect = ViewRect.Scale(ActiveScreenPercentage);
+		if (FamilyActiveViewRect.IsEmpty())
+		{
+			FamilyActiveViewRect = ActiveViewRect;
+		}
+		else
+		{
+			FamilyActiveViewRect.Union(ActiveViewRect);
+		}
+	}
+}
+
+FIntPoint FJumpFloodPassSceneViewExtension::GetBucketedRenderTargetSize(const FIntPoint& RequiredSize)
+{
+	const int32 Bucket = CVarJumpFloodTargetSizeBucket.GetValueOnGameThread();
+	if (Bucket <= 0)
+	{
+		return RequiredSize;
+	}
+
+	return FIntPoint(FMath::DivideAndRoundUp(RequiredSize.X, Bucket) * Bucket, FMath::DivideAndRoundUp(RequiredSize.Y, Bucket) * Bucket);
+}
+
+void FJumpFloodPassSceneViewExtension::UpdateRenderTargetSize(const FIntPoint& RequiredSize)
+{
+	const FIntPoint CurrentSize(PrimaryRenderTarget->SizeX, PrimaryRenderTarget->SizeY);
+	const FIntPoint BucketedSize = GetBucketedRenderTargetSize(RequiredSize);
+
+	FIntPoint NewSize = CurrentSize;
+	if (CurrentSize.X < RequiredSize.X || CurrentSize.Y < RequiredSize.Y)
+	{
+		//  Anything smaller would clip the views, so growing can't wait. A side that could shrink is left for the delay to decide
+		NewSize = CurrentSize.ComponentMax(BucketedSize);
+		RenderTargetShrinkFrameCount = 0;
+	}
+	else if (BucketedSize != CurrentSize)
+	{
+		if (++RenderTargetShrinkFrameCount > CVarJumpFloodTargetShrinkDelay.GetValueOnGameThread())
+		{
+			NewSize = BucketedSize;
+			RenderTargetShrinkFrameCount = 0;
+		}
+	}
+	else
+	{
+		RenderTargetShrinkFrameCount = 0;
+	}
+
+	//  Resizing recreates the resources on the render thread, rather than releasing and initializing them from this one
+	if (NewSize != CurrentSize)
+	{
+		PrimaryRenderTarget->ResizeTarget(NewSize.X, NewSize.Y);
+		SecondaryRenderTarget->ResizeTarget(NewSize.X, NewSize.Y);
+	}
+}
+
+void FJumpFloodPassSceneViewExtension::UpdateViewportParameters(const FSceneViewFamily& InViewFamily) const
+{
+	if (!IsValid(ViewportParameterCollection) || FamilyActiveViewRect.IsEmpty())
+	{
+		return;
+	}
+
+	UWorld* World = InViewFamily.Scene ? InViewFamily.Scene->GetWorld() : nullptr;
+	UMaterialParameterCollectionInstance* ParameterCollectionInstance = World ? World->GetParameterCollectionInstance(ViewportParameterCollection) : nullptr;
+	if (!ParameterCollectionInstance)
+	{
+		return;
+	}
+
+	const FVector2D TargetSizeInverse(1.0 / PrimaryRenderTarget->SizeX, 1.0 / PrimaryRenderTarget->SizeY);
+	const FVector2D ViewportMin = FVector2D(FamilyActiveViewRect.Min) * TargetSizeInverse;
+	const FVector2D ViewportMax = FVector2D(FamilyActiveViewRect.Max) * TargetSizeInverse;
+
+	ParameterCollectionInstance->SetVectorParameterValue(JumpFloodViewportParameterName, FLinearColor(ViewportMin.X, ViewportMin.Y, ViewportMax.X, ViewportMax.Y));
+}
+
+void FJumpFloodPassSceneViewExtension::BeginRenderViewFamily(FSceneViewFamily& InViewFamily)
+{
+	SCOPE_CYCLE_COUNTER(STAT_JumpFloodBeginRenderViewFamily);
+	CSV_SCOPED_TIMING_STAT(JumpFlood, BeginRenderViewFamily);
+	TRACE_CPUPROFILER_EVENT_SCOPE(JumpFlood_BeginRenderViewFamily);
+
+	//  However often the sources changed since the last family, the render thread only gets the latest of them
+	if (bSeedSourcesDirty)
+	{
+		bSeedSourcesDirty = false;
+
+		TArray<FJumpFloodSeedSource> Snapshot;
+		SeedSources.GenerateValueArray(Snapshot);
+
+		ENQUEUE_RENDER_COMMAND(JumpFloodSeedSources)(
+			[Extension = StaticCastSharedRef<FJumpFloodPassSceneViewExtension>(AsShared()), Snapshot = MoveTemp(Snapshot)](FRHICommandListImmediate& RHICmdList) mutable
+			{
+				Extension->SeedSources_RenderThread = MoveTemp(Snapshot);
+				++Extension->SeedSourcesRevision_RenderThread;
+			});
+	}
+
+	if (bFieldQueriesDirty)
+	{
+		bFieldQueriesDirty = false;
+
+		TArray<int32> QueryIds;
+		TArray<FVector2f> QueryPoints;
+		FieldQueries.GenerateKeyArray(QueryIds);
+		FieldQueries.GenerateValueArray(QueryPoints);
+
+		ENQUEUE_RENDER_COMMAND(JumpFloodFieldQueries)(
+			[Extension = StaticCastSharedRef<FJumpFloodPassSceneViewExtension>(AsShared()), QueryIds = MoveTemp(QueryIds), QueryPoints = MoveTemp(QueryPoints), ViewKey = FieldQueryViewKey](FRHICommandListImmediate& RHICmdList) mutable
+			{
+				Extension->FieldQueryIds_RenderThread = MoveTemp(QueryIds);
+				Extension->FieldQueryPoints_RenderThread = MoveTemp(QueryPoints);
+				Extension->FieldQueryViewKey_RenderThread = ViewKey;
+			});
+	}
+
+	//  Readbacks are polled every family rather than only when a view floods, so answers and stats still arrive on frames where
+	//  nothing is flooded, such as while the view is skipped or the queried view isn't rendered
+	ENQUEUE_RENDER_COMMAND(JumpFloodReadbacks)(
+		[Extension = StaticCastSharedRef<FJumpFloodPassSceneViewExtension>(AsShared())](FRHICommandListImmediate& RHICmdList)
+		{
+			Extension->ProcessFieldQueryReadbacks_RenderThread();
+			Extension->ProcessDirtyTileReadbacks_RenderThread();
+		});
+
+	//  Sized once for the whole family, rather than per view. Unused while the field goes straight to post processing
+	if (!IsPublishingField() && FamilyRenderTargetSize.X > 0 && FamilyRenderTargetSize.Y > 0)
+	{
+		UpdateRenderTargetSize(FamilyRenderTargetSize);
+		UpdateViewportParameters(InViewFamily);
+	}
+}
+
+int32 FJumpFloodPassSceneViewExtension::AddSeedSource(FJumpFloodSeedSource&& SeedSource)
+{
+	check(IsInGameThread());
+
+	const int32 SeedSourceId = NextSeedSourceId++;
+	SeedSources.Add(SeedSourceId, MoveTemp(SeedSource));
+	bSeedSourcesDirty = true;
+
+	return SeedSourceId;
+}
+
+bool FJumpFloodPassSceneViewExtension::UpdateSeedSourcePoints(int32 SeedSourceId, TConstArrayView<FVector> Points)
+{
+	check(IsInGameThread());
+
+	FJumpFloodSeedSource* SeedSource = SeedSources.Find(SeedSourceId);
+	if (!SeedSource)
+	{
+		return false;
+	}
+
+	SeedSource->Points.Reset();
+	SeedSource->Points.Append(Points.GetData(), Points.Num());
+	bSeedSourcesDirty = true;
+
+	return true;
+}
+
+void FJumpFloodPassSceneViewExtension::RemoveSeedSource(int32 SeedSourceId)
+{
+	check(IsInGameThread());
+
+	if (SeedSources.Remove(SeedSourceId) > 0)
+	{
+		bSeedSourcesDirty = true;
+	}
+}
+
+void FJumpFloodPassSceneViewExtension::ClearSeedSources()
+{
+	check(IsInGameThread());
+
+	if (SeedSources.Num() > 0)
+	{
+		SeedSources.Reset();
+		bSeedSourcesDirty = true;
+	}
+}
+
+int32 FJumpFloodPassSceneViewExtension::AddFieldQuery(const FVector2D& ViewUV)
+{
+	check(IsInGameThread());
+
+	const int32 FieldQueryId = NextFieldQueryId++;
+	FieldQueries.Add(FieldQueryId, FVector2f(ViewUV));
+	bFieldQueriesDirty = true;
+
+	return FieldQueryId;
+}
+
+bool FJumpFloodPassSceneViewExtension::UpdateFieldQuery(int32 FieldQueryId, const FVector2D& ViewUV)
+{
+	check(IsInGameThread());
+
+	FVector2f* FieldQuery = FieldQueries.Find(FieldQueryId);
+	if (!FieldQuery)
+	{
+		return false;
+	}
+
+	*FieldQuery = FVector2f(ViewUV);
+	bFieldQueriesDirty = true;
+
+	return true;
+}
+
+void FJumpFloodPassSceneViewExtension::RemoveFieldQuery(int32 FieldQueryId)
+{
+	check(IsInGameThread());
+
+	if (FieldQueries.Remove(FieldQueryId) > 0)
+	{
+		bFieldQueriesDirty = true;
+	}
+}
+
+void FJumpFloodPassSceneViewExtension::ClearFieldQueries()
+{
+	check(IsInGameThread());
+
+	if (FieldQueries.Num() > 0)
+	{
+		FieldQueries.Reset();
+		bFieldQueriesDirty = true;
+	}
+}
+
+void FJumpFloodPassSceneViewExtension::SetFieldQueryViewKey(uint32 ViewKey)
+{
+	check(IsInGameThread());
+
+	if (FieldQueryViewKey != ViewKey)
+	{
+		FieldQueryViewKey = ViewKey;
+		bFieldQueriesDirty = true;
+	}
+}
+
+bool FJumpFloodPassSceneViewExtension::GetFieldQueryResult(int32 FieldQueryId, FJumpFloodFieldQueryResult& OutResult) const
+{
+	check(IsInGameThread());
+
+	//  Readbacks already in flight can still answer a removed query
+	if (!FieldQueries.Contains(FieldQueryId))
+	{
+		return false;
+	}
+
+	FScopeLock Lock(&FieldQueryResultsCriticalSection);
+
+	const FJumpFloodFieldQueryResult* Result = FieldQueryResults.Find(FieldQueryId);
+	if (!Result)
+	{
+		return false;
+	}
+
+	OutResult = *Result;
+	return true;
+}
+
+void FJumpFloodPassSceneViewExtension::PostRenderBasePassDeferred_RenderThread(FRDGBuilder& GraphBuilder, FSceneView& InView, const FRenderTargetBindingSlots& RenderTargets, TRDGUniformBufferRef<FSceneTextureUniformParameters> SceneTextures)
+{
+	SCOPE_CYCLE_COUNTER(STAT_JumpFloodFloodSetup);
+	CSV_SCOPED_TIMING_STAT(JumpFlood, FloodSetup);
+	TRACE_CPUPROFILER_EVENT_SCOPE(JumpFlood_FloodSetup);
+
+	checkSlow(InView.bIsViewInfo);
+	const FViewInfo& ViewInfo = static_cast<const FViewInfo&>(InView);
+
+	FSceneViewExtensionBase::PostRenderBasePassDeferred_RenderThread(GraphBuilder, InView, RenderTargets, SceneTextures);
+
+	if (!IsActiveThisFrame_Internal(FSceneViewExtensionContext{}))
+	{
+		return;
+	}
+
+	//  Desktop stereo renders both eyes side by side into the same scene textures, so the primary eye floods the pair at once
+	if (IStereoRendering::IsASecondaryView(InView))
+	{
+		return;
+	}
+
+	if (!IsFloodedViewType(InView))
+	{
+		INC_DWORD_STAT(STAT_JumpFloodViewsSkippedViewType);
+		return;
+	}
+
+	FIntRect ViewRect = ViewInfo.ViewRect;
+	int32 ViewSplitX = 0;
+
+	//  Custom depth is only drawn when something visible asks for it, and without it there is no stencil to seed from
+	bool bHasCustomDepthPrimitives = ViewInfo.bHasCustomDepthPrimitives;
+
+	if (IStereoRendering::IsStereoEyeView(InView))
+	{
+		for (const FSceneView* FamilyView : InView.Family->Views)
+		{
+			if (FamilyView != &InView && IStereoRendering::IsASecondaryView(*FamilyView))
+			{
+				const FViewInfo* EyeViewInfo = static_cast<const FViewInfo*>(FamilyView);
+				ViewSplitX = EyeViewInfo->ViewRect.Min.X;
+				ViewRect.Union(EyeViewInfo->ViewRect);
+				bHasCustomDepthPrimitives |= EyeViewInfo->bHasCustomDepthPrimitives;
+			}
+		}
+	}
+
+	const bool bStencilSeeds = bHasCustomDepthPrimitives && CVarJumpFloodStencilSeeds.GetValueOnRenderThread() > 0;
+
+	static const auto CVar = IConsoleManager::Get().FindTConsoleVariableDataFloat(TEXT("r.JumpFloodPass.RenderScale"));
+	float RenderScale = CVar->GetValueOnRenderThread() > 0.0f ? CVar->GetValueOnRenderThread() : 1.0f;
+
+	const float MaxDistanceOverride = CVarJumpFloodMaxDistance.GetValueOnRenderThread();
+	const float MaxDistance = MaxDistanceOverride >= 0.0f ? MaxDistanceOverride : UJumpFloodPassSettings::GetMaxFloodDistance();
+
+	//  Budgeting trades the flood's quality for its GPU time, going by timings that arrive a few frames late
+	const float BudgetOverride = CVarJumpFloodBudget.GetValueOnRenderThread();
+	const float BudgetMs = BudgetOverride >= 0.0f ? BudgetOverride : UJumpFloodPassSettings::GetGPUBudget();
+	const bool bUseBudget = BudgetMs > 0.0f;
+
+	int32 FloodPassReduction = 0;
+	int32 RefinementPassCount = FMath::Max(CVarJumpFloodRefinementPasses.GetValueOnRenderThread(), 0);
+
+	if (bUseBudget)
+	{
+		UpdateBudget_RenderThread(ViewInfo.Family->FrameNumber, BudgetMs);
+
+		RenderScale *= BudgetState.RenderScaleFraction;
+		FloodPassReduction = BudgetState.FloodPassReduction;
+		RefinementPassCount = BudgetState.RefinementPassCount;
+	}
+	else
+	{
+		ResetBudget_RenderThread();
+	}
+
+	const FGlobalShaderMap* GlobalShaderMap = GetGlobalShaderMap(GMaxRHIFeatureLevel);
+
+	RDG_EVENT_SCOPE(GraphBuilder, "JumpFlood");
+	RDG_GPU_STAT_SCOPE(GraphBuilder, JumpFlood);
+	RDG_CSV_STAT_EXCLUSIVE_SCOPE(GraphBuilder, JumpFlood);
+
+	//  Either the last flood step resolves into transient textures handed to post processing, or the result is copied into the
+	//  render target assets
+	const bool bPublishField = IsPublishingField();
+
+	FRDGTextureRef PrimaryRenderTargetTexture = nullptr;
+	FRDGTextureRef SecondaryRenderTargetTexture = nullptr;
+	FIntRect RenderViewport = ViewRect;
+
+	if (!bPublishField)
+	{
+		if (ArePooledRenderTargetsStale_RenderThread())
+		{
+			CreatePooledRenderTargets_RenderThread();
+		}
+
+		PrimaryRenderTargetTexture = GraphBuilder.RegisterExternalTexture(PooledPrimaryRenderTarget, TEXT("JumpFloodTarget_0"));
+		SecondaryRenderTargetTexture = GraphBuilder.RegisterExternalTexture(PooledSecondaryRenderTarget, TEXT("JumpFloodTarget_1"));
+
+		//  The targets are laid out like the scene textures, with each view resolving into its own view rect
+		RenderViewport.Clip(FIntRect(FIntPoint::ZeroValue, PrimaryRenderTargetTexture->Desc.Extent));
+	}
+
+	if (RenderViewport.IsEmpty())
+	{
+		return;
+	}
+
+	//  The intermediates only cover this view, so each view floods at its own size
+	FRDGTextureDesc IntermediateTargetDesc = bPublishField
+		? FRDGTextureDesc::Create2D(FIntPoint::ZeroValue, PF_A32B32G32R32F, FClearValueBinding::Transparent, TexCreate_RenderTargetable | TexCreate_ShaderResource)
+		: PrimaryRenderTargetTexture->Desc;
+	IntermediateTargetDesc.ClearValue = FClearValueBinding::Transparent;
+	IntermediateTargetDesc.Extent =
+		FIntPoint {
+			FMath::Max((int32) ((float) RenderViewport.Width() * RenderScale), 1),
+			FMath::Max((int32) ((float) RenderViewport.Height() * RenderScale), 1) };
+
+	const FIntRect IntermediateViewport = FIntRect(0, 0, IntermediateTargetDesc.Extent.X, IntermediateTargetDesc.Extent.Y);
+	const float ViewSplit = ViewSplitX > RenderViewport.Min.X
+		? (float) (ViewSplitX - RenderViewport.Min.X) * IntermediateViewport.Width() / RenderViewport.Width()
+		: 0.0f;
+
+	FJumpFloodViewState& ViewState = FindOrAddViewState_RenderThread(ViewInfo);
+
+	//  Views without a view state all share key 0, so nothing of one can be told apart from another's on the next frame
+	const bool bPersistentViewState = ViewInfo.GetViewKey() != 0;
+
+	//  Every way on from here writes the view's region of the render targets, if only to clear it
+	const bool bLastOutputWriter = !bPublishField && UpdateOutputWriter_RenderThread(ViewInfo.GetViewKey(), ViewInfo.Family->FrameNumber, RenderViewport);
+
+	//  The exact transform and the hierarchy only exist as compute passes over packed seeds, so asking for either selects both
+	const bool bComputeOnlyMode = CVarJumpFloodExact.GetValueOnRenderThread() > 0 || CVarJumpFloodHierarchical.GetValueOnRenderThread() > 0;
+	const bool bUseCompute = (CVarJumpFloodCompute.GetValueOnRenderThread() > 0 || bComputeOnlyMode) && IsFeatureLevelSupported(GMaxRHIShaderPlatform, ERHIFeatureLevel::SM5);
+
+	if (bComputeOnlyMode && !bUseCompute)
+	{
+		static bool bWarnedComputeOnlyMode = false;
+		if (!bWarnedComputeOnlyMode)
+		{
+			bWarnedComputeOnlyMode = true;
+			UE_LOG(LogJumpFloodPass, Warning, TEXT("r.JumpFloodPass.Exact and r.JumpFloodPass.Hierarchical need SM5, so the jump flood runs without them"));
+		}
+	}
+
+	//  Seed sources are rasterized by a compute pass, whichever way the flood itself runs
+	TArray<FJumpFloodSeedPiece> SeedPieces;
+	if (IsFeatureLevelSupported(GMaxRHIShaderPlatform, ERHIFeatureLevel::SM5))
+	{
+		BuildSeedPieces_RenderThread(ViewInfo, RenderViewport, IntermediateViewport, SeedPieces);
+	}
+
+	//  With nothing to seed from, the whole field would come out empty
+	if (!bStencilSeeds && SeedPieces.Num() == 0)
+	{
+		INC_DWORD_STAT(STAT_JumpFloodViewsSkippedEmpty);
+
+		ViewState.History = FJumpFloodHistory();
+
+		if (!bPublishField)
+		{
+			AddClearRenderTargetPass(GraphBuilder, PrimaryRenderTargetTexture, FLinearColor::Transparent, RenderViewport);
+			AddClearRenderTargetPass(GraphBuilder, SecondaryRenderTargetTexture, FLinearColor::Transparent, RenderViewport);
+
+			//  Queries still find out there is no seed
+			FIntRect FieldViewport = ViewInfo.ViewRect;
+			FieldViewport.Clip(RenderViewport);
+			AddFieldQueryPass_RenderThread(GraphBuilder, GlobalShaderMap, ViewInfo, PrimaryRenderTargetTexture, SecondaryRenderTargetTexture, FieldViewport);
+		}
+		return;
+	}
+
+	INC_DWORD_STAT(STAT_JumpFloodViewsFlooded);
+
+	FRHIRenderQuery* BudgetEndQuery = bUseBudget ? AddBudgetTimerBeginPass_RenderThread(GraphBuilder) : nullptr;
+
+	//  Grouped floods have a chain of their own, without temporal reuse, tile lists or the hierarchy
+	const int32 GroupMode = FMath::Clamp(CVarJumpFloodGroups.GetValueOnRenderThread(), 0, 2);
+	if (GroupMode > 0 && IsFeatureLevelSupported(GMaxRHIShaderPlatform, ERHIFeatureLevel::SM5))
+	{
+		ViewState.History = FJumpFloodHistory();
+
+		//  A grouped field has a distance per group rather than the seed and distance a query answers with
+		if (FieldQueryIds_RenderThread.Num() > 0)
+		{
+			static bool bWarnedFieldQueries = false;
+			if (!bWarnedFieldQueries)
+			{
+				bWarnedFieldQueries = true;
+				UE_LOG(LogJumpFloodPass, Warning, TEXT("Field queries are not answered while r.JumpFloodPass.Groups is set"));
+			}
+		}
+
+		AddGroupFloodPasses_RenderThread(
+			GraphBuilder,
+			GlobalShaderMap,
+			ViewInfo,
+			RenderViewport,
+			IntermediateViewport,
+			SeedPieces,
+			GroupMode,
+			bStencilSeeds,
+			CVarJumpFloodPayload.GetValueOnRenderThread() > 0,
+			GetFloodPassCount(IntermediateViewport, MaxDistance, RenderScale, FloodPassReduction),
+			RefinementPassCount,
+			MaxDistance,
+			ViewSplit,
+			PrimaryRenderTargetTexture,
+			SecondaryRenderTargetTexture);
+
+		if (BudgetEndQuery)
+		{
+			AddTimestampPass(GraphBuilder, BudgetEndQuery);
+		}
+		return;
+	}
+
+	if (bUseCompute || SeedPieces.Num() > 0)
+	{
+		IntermediateTargetDesc.Flags |= TexCreate_UAV;
+	}
+
+	//  Async floods overlap whatever the graphics queue does next, as long as nothing reads them before post processing
+	const bool bUseAsyncCompute = bUseCompute && !bUseBudget && GSupportsEfficientAsyncCompute && CVarJumpFloodAsyncCompute.GetValueOnRenderThread() > 0;
+	const ERDGPassFlags FloodPassFlags = bUseAsyncCompute ? ERDGPassFlags::AsyncCompute : ERDGPassFlags::Compute;
+
+	const bool bPackedSeeds = CVarJumpFloodPackedIntermediate.GetValueOnRenderThread() > 0 || (bUseCompute && bComputeOnlyMode);
+	if (bPackedSeeds)
+	{
+		IntermediateTargetDesc.Format = PF_R32_UINT;
+	}
+
+	//  The exact transform has no steps to reduce or refine, and tiles of it can't be flooded apart from the rest
+	const bool bExactFlood = bUseCompute && bPackedSeeds && CVarJumpFloodExact.GetValueOnRenderThread() > 0;
+
+	//  Amortized floods seed and flood into textures of their own, kept between frames. Seed sources have no stencil in the scene
+	//  to read back at their reprojected seeds, so while any are registered the flood runs in full and resolves their stencil
+	const int32 AmortizeFrameCount = bPersistentViewState && bUseCompute && bPackedSeeds && !bExactFlood && ViewSplit <= 0.0f && SeedPieces.Num() == 0
+		? FMath::Clamp(CVarJumpFloodAmortizeFrames.GetValueOnRenderThread(), 1, 4)
+		: 1;
+	const bool bAmortizedFlood = AmortizeFrameCount > 1;
+	if (!bAmortizedFlood)
+	{
+		ViewState.AmortizedFlood = FJumpFloodAmortizedFlood();
+	}
+
+	FRDGTextureRef PrimaryTextures[] = {
+		GraphBuilder.CreateTexture(IntermediateTargetDesc, TEXT("JumpFloodIntermediateTarget_0_0")),
+		GraphBuilder.CreateTexture(IntermediateTargetDesc, TEXT("JumpFloodIntermediateTarget_0_1")),
+	};
+
+	//  Without a payload the resolve only needs the seed, so unpacked intermediates leave out their stencil and depth
+	const bool bPayload = CVarJumpFloodPayload.GetValueOnRenderThread() > 0;
+	const bool bSecondaryIntermediates = !bPackedSeeds && bPayload;
+
+	FRDGTextureRef SecondaryTextures[] = {
+		bSecondaryIntermediates ? GraphBuilder.CreateTexture(IntermediateTargetDesc, TEXT("JumpFloodIntermediateTarget_1_0")) : nullptr,
+		bSecondaryIntermediates ? GraphBuilder.CreateTexture(IntermediateTargetDesc, TEXT("JumpFloodIntermediateTarget_1_1")) : nullptr,
+	};
+
+	AddTextureMemoryStats(
+		GetTextureMemoryKB(IntermediateTargetDesc.Extent, IntermediateTargetDesc.Format) * (bSecondaryIntermediates ? 4 : 2)
+			+ (bPublishField ? GetTextureMemoryKB(IntermediateTargetDesc.Extent, PF_A32B32G32R32F) * 2 : 0),
+		0);
+
+	int32 ReadIndex  = 0;
+	int32 WriteIndex = 1;
+
+	//  Tile lists restricting where the seed, flood and resolve passes run. Null runs them over the whole view
+	FJumpFloodTileList FloodTiles;
+	FJumpFloodTileList ResolveTiles;
+
+	const FJumpFloodTileList* SeedTileList = nullptr;
+	const FJumpFloodTileList* FloodTileList = nullptr;
+	const FJumpFloodTileList* ResolveTileList = nullptr;
+	bool bClearOutputs = true;
+
+	//  Temporal change detection
+	const bool bUseTemporal = bPersistentViewState && bUseCompute && !bPublishField && !bAmortizedFlood && CVarJumpFloodTemporal.GetValueOnRenderThread() > 0;
+	if (bUseTemporal)
+	{
+		RDG_EVENT_SCOPE(GraphBuilder, "JumpFlood - Temporal");
+
+		FJumpFloodHistory CurrentHistory;
+		CurrentHistory.OutputTexture = PooledPrimaryRenderTarget->GetRHI();
+		CurrentHistory.OutputViewport = RenderViewport;
+		CurrentHistory.IntermediateExtent = IntermediateTargetDesc.Extent;
+		CurrentHistory.MaxDistance = MaxDistance;
+		CurrentHistory.bPackedSeeds = bPackedSeeds;
+		CurrentHistory.bExactFlood = bExactFlood;
+		CurrentHistory.bPayload = bPayload;
+		CurrentHistory.FloodPassReduction = FloodPassReduction;
+		CurrentHistory.RefinementPassCount = RefinementPassCount;
+		CurrentHistory.SeedSourcesRevision = SeedSourcesRevision_RenderThread;
+
+		//  Jitter is left out so that anti-aliasing alone doesn't count as the view changing
+		CurrentHistory.ViewMatrix = ViewInfo.ViewMatrices.GetViewMatrix();
+		CurrentHistory.ProjectionMatrix = ViewInfo.ViewMatrices.GetProjectionNoAAMatrix();
+		CurrentHistory.ViewOrigin = ViewInfo.ViewMatrices.GetViewOrigin();
+
+		const bool bReuseHistory = bLastOutputWriter && IsHistoryReusable(ViewState.History, CurrentHistory);
+		FRDGTextureRef PreviousTileHash = bReuseHistory ? GraphBuilder.RegisterExternalTexture(ViewState.History.TileHash, TEXT("JumpFloodPreviousTileHash")) : nullptr;
+
+		ViewState.History = CurrentHistory;
+		const FJumpFloodTileMask DirtyTiles = AddTileHashPass_RenderThread(GraphBuilder, GlobalShaderMap, ViewInfo, RenderViewport, IntermediateViewport, PreviousTileHash, ViewState.History);
+
+		if (bReuseHistory)
+		{
+			//  A changed tile moves seeds up to a texel into its neighbours, which then reach MaxDistance further, through
+			//  flood steps that can pass through texels up to that far again
+			const float IntermediateMaxDistance = MaxDistance * RenderScale;
+			const int32 ResolveTileRadius = MaxDistance > 0.0f ? FMath::CeilToInt((IntermediateMaxDistance + 1.0f) / JumpFloodTileSize) : INDEX_NONE;
+			const int32 FloodTileRadius = MaxDistance > 0.0f ? FMath::CeilToInt((IntermediateMaxDistance * 3.0f + 1.0f) / JumpFloodTileSize) : INDEX_NONE;
+
+			FloodTiles = AddTileListPasses_RenderThread(GraphBuilder, GlobalShaderMap, DirtyTiles, FloodTileRadius);
+			ResolveTiles = AddTileListPasses_RenderThread(GraphBuilder, GlobalShaderMap, DirtyTiles, ResolveTileRadius);
+
+			//  Texels outside the flooded tiles have to read as empty on both sides of the ping-pong
+			for (int32 Index = 0; Index < 2; ++Index)
+			{
+				AddClearRenderTargetPass(GraphBuilder, PrimaryTextures[Index]);
+				if (bSecondaryIntermediates)
+				{
+					AddClearRenderTargetPass(GraphBuilder, SecondaryTextures[Index]);
+				}
+			}
+
+			//  Everything outside the resolved tiles keeps the previous result
+			SeedTileList = &FloodTiles;
+			FloodTileList = &FloodTiles;
+			ResolveTileList = &ResolveTiles;
+			bClearOutputs = false;
+		}
+	}
+	else
+	{
+		ViewState.History = FJumpFloodHistory();
+	}
+
+	//  Init Pass
+	if (bStencilSeeds && !bAmortizedFlood)
+	{
+		AddSeedPass_RenderThread(
+			GraphBuilder,
+			GlobalShaderMap,
+			ViewInfo,
+			RenderViewport,
+			IntermediateViewport,
+			PrimaryTextures[WriteIndex],
+			SecondaryTextures[WriteIndex],
+			bPackedSeeds,
+			SeedTileList);
+	}
+	else if (!SeedTileList && !bAmortizedFlood)
+	{
+		AddClearRenderTargetPass(GraphBuilder, PrimaryTextures[WriteIndex]);
+		if (bSecondaryIntermediates)
+		{
+			AddClearRenderTargetPass(GraphBuilder, SecondaryTextures[WriteIndex]);
+		}
+	}
+
+	//  Packed seeds have nowhere to carry a seed source's stencil, so it is kept at the seed's texel for the resolve to read
+	FRDGTextureRef SeedStencilTexture = nullptr;
+	if (SeedPieces.Num() > 0)
+	{
+		if (bPackedSeeds && bPayload)
+		{
+			SeedStencilTexture = GraphBuilder.CreateTexture(
+				FRDGTextureDesc::Create2D(IntermediateTargetDesc.Extent, PF_R8_UINT, FClearValueBinding::Black, TexCreate_ShaderResource | TexCreate_UAV),
+				TEXT("JumpFloodSeedStencil"));
+			AddClearUAVPass(GraphBuilder, GraphBuilder.CreateUAV(SeedStencilTexture), 0u);
+		}
+
+		AddSeedSourcePass_RenderThread(
+			GraphBuilder,
+			GlobalShaderMap,
+			SeedPieces,
+			PrimaryTextures[WriteIndex],
+			SecondaryTextures[WriteIndex],
+			SeedStencilTexture,
+			bPackedSeeds);
+	}
+
+	//  Tile classification
+	const bool bUseTileList = bUseCompute && !bExactFlood && !bAmortizedFlood && MaxDistance > 0.0f && CVarJumpFloodTileClassification.GetValueOnRenderThread() > 0;
+	if (bUseTileList && !FloodTileList)
+	{
+		//  Texels in the tiles that get skipped have to read as empty
+		AddClearRenderTargetPass(GraphBuilder, PrimaryTextures[ReadIndex]);
+		if (bSecondaryIntermediates)
+		{
+			AddClearRenderTargetPass(GraphBuilder, SecondaryTextures[ReadIndex]);
+		}
+
+		const int32 TileRadius = FMath::CeilToInt(MaxDistance * RenderScale / JumpFloodTileSize);
+		FloodTiles = AddTileClassificationPasses_RenderThread(GraphBuilder, GlobalShaderMap, IntermediateViewport, PrimaryTextures[WriteIndex], bPackedSeeds, TileRadius);
+
+		FloodTileList = &FloodTiles;
+		ResolveTileList = &FloodTiles;
+	}
+
+	//  Field written by the last flood step when it is published straight to post processing
+	FJumpFloodResolveOutput ResolveOutput;
+	if (bPublishField)
+	{
+		FRDGTextureDesc FieldDesc = FRDGTextureDesc::Create2D(IntermediateTargetDesc.Extent, PF_A32B32G32R32F, FClearValueBinding::Transparent, TexCreate_ShaderResource);
+		FieldDesc.Flags |= bUseCompute ? TexCreate_UAV : TexCreate_RenderTargetable;
+
+		ResolveOutput.PrimaryTexture = GraphBuilder.CreateTexture(FieldDesc, TEXT("JumpFloodField_0"));
+		ResolveOutput.SecondaryTexture = GraphBuilder.CreateTexture(FieldDesc, TEXT("JumpFloodField_1"));
+		ResolveOutput.ViewInfo = &ViewInfo;
+		ResolveOutput.Viewport = RenderViewport;
+		ResolveOutput.MaxDistance = MaxDistance;
+		ResolveOutput.SeedStencilTexture = SeedStencilTexture;
+		ResolveOutput.bPayload = bPayload;
+
+		//  Only the listed tiles get written
+		if (FloodTileList)
+		{
+			AddClearUAVPass(GraphBuilder, GraphBuilder.CreateUAV(ResolveOutput.PrimaryTexture), FVector4f(0.0f, 0.0f, 0.0f, 0.0f));
+			AddClearUAVPass(GraphBuilder, GraphBuilder.CreateUAV(ResolveOutput.SecondaryTexture), FVector4f(0.0f, 0.0f, 0.0f, 0.0f));
+		}
+	}
+
+	const FJumpFloodResolveOutput* LastStepResolveOutput = bPublishField ? &ResolveOutput : nullptr;
+
+	//  Flood Passes
+	{
+		float LargestSide = FMath::Max(IntermediateViewport.Width(), IntermediateViewport.Height());
+		float LargestSideInverse = 1.0f / LargestSide;
+
+		const int32 FloodPassCount = GetFloodPassCount(IntermediateViewport, MaxDistance, RenderScale, FloodPassReduction);
+
+		//  With refinement passes, the full flood hands its result on rather than resolving it
+		const FJumpFloodResolveOutput* FloodResolveOutput = RefinementPassCount > 0 ? nullptr : LastStepResolveOutput;
+
+		//  Tile lists only cover the full resolution chain
+		const int32 HierarchyLevelCount = bUseCompute && bPackedSeeds && !FloodTileList
+			? FMath::Clamp(CVarJumpFloodHierarchical.GetValueOnRenderThread(), 0, 3)
+			: 0;
+
+		if (bAmortizedFlood)
+		{
+			Swap(ReadIndex, WriteIndex);
+			PrimaryTextures[WriteIndex] = AddAmortizedFloodPasses_RenderThread(
+				GraphBuilder,
+				GlobalShaderMap,
+				ViewInfo,
+				ViewState.AmortizedFlood,
+				RenderViewport,
+				IntermediateViewport,
+				bStencilSeeds,
+				AmortizeFrameCount,
+				FloodPassCount,
+				RefinementPassCount,
+				MaxDistance,
+				FloodPassFlags);
+		}
+		else if (bExactFlood)
+		{
+			Swap(ReadIndex, WriteIndex);
+			AddExactFloodPasses_RenderThread(
+				GraphBuilder,
+				GlobalShaderMap,
+				PrimaryTextures[ReadIndex],
+				PrimaryTextures[WriteIndex],
+				ViewSplit,
+				FloodPassFlags);
+		}
+		else if (bUseCompute && HierarchyLevelCount > 0)
+		{
+			Swap(ReadIndex, WriteIndex);
+			AddHierarchicalFloodPasses_RenderThread(
+				GraphBuilder,
+				GlobalShaderMap,
+				IntermediateViewport,
+				PrimaryTextures[ReadIndex],
+				PrimaryTextures[WriteIndex],
+				HierarchyLevelCount,
+				FloodPassCount,
+				ViewSplit,
+				FloodPassFlags);
+		}
+		else if (bUseCompute)
+		{
+			//Adding a 1-step pass before full flood Reduces error rate
+			Swap(ReadIndex, WriteIndex);
+			AddFloodComputePass_RenderThread(
+				GraphBuilder,
+				GlobalShaderMap,
+				IntermediateViewport,
+				PrimaryTextures[ReadIndex],
+				PrimaryTextures[WriteIndex],
+				SecondaryTextures[ReadIndex],
+				SecondaryTextures[WriteIndex],
+				bPackedSeeds,
+				0,
+				1.0f,
+				ViewSplit,
+				FloodPassFlags,
+				FloodTileList);
+
+			//  Steps of at least a tile get their own dispatch
+			const int32 TileExponent = FMath::FloorLog2(JumpFloodTileSize);
+			for (int FloodExponent = FloodPassCount; FloodExponent >= TileExponent; FloodExponent -= 1)
+			{
+				Swap(ReadIndex, WriteIndex);
+				AddFloodComputePass_RenderThread(
+					GraphBuilder,
+					GlobalShaderMap,
+					IntermediateViewport,
+					PrimaryTextures[ReadIndex],
+					PrimaryTextures[WriteIndex],
+					SecondaryTextures[ReadIndex],
+					SecondaryTextures[WriteIndex],
+					bPackedSeeds,
+					FloodExponent,
+					1.0f,
+					ViewSplit,
+					FloodPassFlags,
+					FloodTileList);
+			}
+		}
+
+		if (bExactFlood || bAmortizedFlood)
+		{
+			//  A step over an exact field changes nothing, so one is only run to resolve the published field. Reprojected
+			//  seeds always get one, to patch where the camera's motion pulled them apart
+			if (LastStepResolveOutput || bAmortizedFlood)
+			{
+				Swap(ReadIndex, WriteIndex);
+				AddFloodComputePass_RenderThread(
+					GraphBuilder,
+					GlobalShaderMap,
+					IntermediateViewport,
+					PrimaryTextures[ReadIndex],
+					PrimaryTextures[WriteIndex],
+					nullptr,
+					nullptr,
+					true,
+					0,
+					1.0f,
+					ViewSplit,
+					FloodPassFlags,
+					FloodTileList,
+					LastStepResolveOutput);
+			}
+		}
+		else if (bUseCompute)
+		{
+			//  Every remaining step is flooded within groupshared memory
+			Swap(ReadIndex, WriteIndex);
+			AddFloodTilePass_RenderThread(
+				GraphBuilder,
+				GlobalShaderMap,
+				IntermediateViewport,
+				PrimaryTextures[ReadIndex],
+				PrimaryTextures[WriteIndex],
+				SecondaryTextures[ReadIndex],
+				SecondaryTextures[WriteIndex],
+				bPackedSeeds,
+				ViewSplit,
+				FloodPassFlags,
+				FloodTileList,
+				FloodResolveOutput);
+
+			for (int FloodExponent = RefinementPassCount - 1; FloodExponent > -1; FloodExponent -= 1)
+			{
+				Swap(ReadIndex, WriteIndex);
+				AddFloodComputePass_RenderThread(
+					GraphBuilder,
+					GlobalShaderMap,
+					IntermediateViewport,
+					PrimaryTextures[ReadIndex],
+					PrimaryTextures[WriteIndex],
+					SecondaryTextures[ReadIndex],
+					SecondaryTextures[WriteIndex],
+					bPackedSeeds,
+					FloodExponent,
+					1.0f,
+					ViewSplit,
+					FloodPassFlags,
+					FloodTileList,
+					FloodExponent == 0 ? LastStepResolveOutput : nullptr);
+			}
+		}
+		else
+		{
+			//Adding a 1-step pass before full flood Reduces error rate
+			Swap(ReadIndex, WriteIndex);
+			AddFloodPass_RenderThread(
+				GraphBuilder,
+				GlobalShaderMap,
+				ViewInfo,
+				IntermediateViewport,
+				PrimaryTextures[ReadIndex],
+				PrimaryTextures[WriteIndex],
+				SecondaryTextures[ReadIndex],
+				SecondaryTextures[WriteIndex],
+				bPackedSeeds,
+				0,
+				ViewSplit,
+				LargestSideInverse,
+				FloodPassCount < 0 ? FloodResolveOutput : nullptr);
+
+			for (int FloodExponent = FloodPassCount; FloodExponent > -1 ; FloodExponent -= 1)
+			{
+				Swap(ReadIndex, WriteIndex);
+				AddFloodPass_RenderThread(
+					GraphBuilder,
+					GlobalShaderMap,
+					ViewInfo,
+					IntermediateViewport,
+					PrimaryTextures[ReadIndex],
+					PrimaryTextures[WriteIndex],
+					SecondaryTextures[ReadIndex],
+					SecondaryTextures[WriteIndex],
+					bPackedSeeds,
+					FloodExponent,
+					ViewSplit,
+					LargestSideInverse,
+					FloodExponent == 0 ? FloodResolveOutput : nullptr);
+			}
+
+			for (int FloodExponent = RefinementPassCount - 1; FloodExponent > -1; FloodExponent -= 1)
+			{
+				Swap(ReadIndex, WriteIndex);
+				AddFloodPass_RenderThread(
+					GraphBuilder,
+					GlobalShaderMap,
+					ViewInfo,
+					IntermediateViewport,
+					PrimaryTextures[ReadIndex],
+					PrimaryTextures[WriteIndex],
+					SecondaryTextures[ReadIndex],
+					SecondaryTextures[WriteIndex],
+					bPackedSeeds,
+					FloodExponent,
+					ViewSplit,
+					LargestSideInverse,
+					FloodExponent == 0 ? LastStepResolveOutput : nullptr);
+			}
+		}
+	}
+
+	if (bPublishField)
+	{
+		PublishField_RenderThread(GraphBuilder, ViewInfo, ResolveOutput, ViewSplit);
+
+		//  The published field is at intermediate resolution, with a primary stereo eye on the left of the split
+		const FIntPoint Extent = ResolveOutput.PrimaryTexture->Desc.Extent;
+		const FIntRect FieldViewport(0, 0, ViewSplit > 0.0f ? FMath::RoundToInt(ViewSplit) : Extent.X, Extent.Y);
+		AddFieldQueryPass_RenderThread(GraphBuilder, GlobalShaderMap, ViewInfo, ResolveOutput.PrimaryTexture, ResolveOutput.SecondaryTexture, FieldViewport);
+
+		if (BudgetEndQuery)
+		{
+			AddTimestampPass(GraphBuilder, BudgetEndQuery);
+		}
+		return;
+	}
+
+	FJumpFloodResolve Resolve;
+	Resolve.View = &ViewInfo;
+	Resolve.PrimaryTexture = PrimaryTextures[WriteIndex];
+	Resolve.SecondaryTexture = SecondaryTextures[WriteIndex];
+	Resolve.PrimaryRenderTargetTexture = PrimaryRenderTargetTexture;
+	Resolve.SecondaryRenderTargetTexture = SecondaryRenderTargetTexture;
+	Resolve.SeedStencilTexture = SeedStencilTexture;
+	Resolve.bPackedSeeds = bPackedSeeds;
+	Resolve.bPayload = bPayload;
+	Resolve.RenderViewport = RenderViewport;
+	Resolve.IntermediateViewport = IntermediateViewport;
+	Resolve.MaxDistance = MaxDistance;
+	Resolve.TileList = ResolveTileList ? *ResolveTileList : FJumpFloodTileList();
+	Resolve.bClearOutputs = bClearOutputs;
+
+	//  Resolving now would make the graphics queue wait on the async flood straight away. Families that don't post process never
+	//  reach PrePostProcessPass_RenderThread, so theirs resolve here regardless
+	const bool bPostProcessFamily = ViewInfo.Family->bResolveScene && ViewInfo.Family->EngineShowFlags.PostProcessing;
+	if (bUseAsyncCompute && bPostProcessFamily)
+	{
+		ResetDeferredWork_RenderThread(GraphBuilder, ViewInfo.Family->FrameNumber);
+		DeferredResolves.Add(Resolve);
+	}
+	else
+	{
+		AddResolvePass_RenderThread(GraphBuilder, GlobalShaderMap, Resolve);
+	}
+
+	if (BudgetEndQuery)
+	{
+		AddTimestampPass(GraphBuilder, BudgetEndQuery);
+	}
+}
+
+void FJumpFloodPassSceneViewExtension::PrePostProcessPass_RenderThread(FRDGBuilder& GraphBuilder, const FSceneView& View, const FPostProcessingInputs& Inputs)
+{
+	if (DeferredWorkGraph != &GraphBuilder)
+	{
+		return;
+	}
+
+	const int32 ResolveIndex = DeferredResolves.IndexOfByPredicate([&View](const FJumpFloodResolve& Resolve) { return Resolve.View == &View; });
+	if (ResolveIndex != INDEX_NONE)
+	{
+		SCOPE_CYCLE_COUNTER(STAT_JumpFloodResolveSetup);
+		CSV_SCOPED_TIMING_STAT(JumpFlood, ResolveSetup);
+		TRACE_CPUPROFILER_EVENT_SCOPE(JumpFlood_ResolveSetup);
+
+		RDG_EVENT_SCOPE(GraphBuilder, "JumpFlood");
+		RDG_GPU_STAT_SCOPE(GraphBuilder, JumpFlood);
+		RDG_CSV_STAT_EXCLUSIVE_SCOPE(GraphBuilder, JumpFlood);
+
+		AddResolvePass_RenderThread(GraphBuilder, GetGlobalShaderMap(GMaxRHIFeatureLevel), DeferredResolves[ResolveIndex]);
+		DeferredResolves.RemoveAtSwap(ResolveIndex);
+	}
+}
+
+void FJumpFloodPassSceneViewExtension::PostRenderViewFamily_RenderThread(FRDGBuilder& GraphBuilder, FSceneViewFamily& InViewFamily)
+{
+	FSceneViewExtensionBase::PostRenderViewFamily_RenderThread(GraphBuilder, InViewFamily);
+
+	if (DeferredWorkGraph != &GraphBuilder || DeferredResolves.IsEmpty())
+	{
+		return;
+	}
+
+	//  Anything a view's post processing didn't pick up still has to reach the render targets by the end of its graph
+	RDG_EVENT_SCOPE(GraphBuilder, "JumpFlood");
+	RDG_GPU_STAT_SCOPE(GraphBuilder, JumpFlood);
+	RDG_CSV_STAT_EXCLUSIVE_SCOPE(GraphBuilder, JumpFlood);
+
+	for (const FJumpFloodResolve& Resolve : DeferredResolves)
+	{
+		AddResolvePass_RenderThread(GraphBuilder, GetGlobalShaderMap(GMaxRHIFeatureLevel), Resolve);
+	}
+	DeferredResolves.Reset();
+}
+
+void FJumpFloodPassSceneViewExtension::AddResolvePass_RenderThread(FRDGBuilder& GraphBuilder, const FGlobalShaderMap* GlobalShaderMap, const FJumpFloodResolve& Resolve)
+{
+	checkSlow(Resolve.View->bIsViewInfo);
+	const FViewInfo& ViewInfo = static_cast<const FViewInfo&>(*Resolve.View);
+
+	const bool bPackedSeeds = Resolve.bPackedSeeds;
+	const bool bUseTileList = Resolve.TileList.Tiles != nullptr;
+	const FIntPoint TextureSize = Resolve.PrimaryTexture->Desc.Extent;
+
+	//  Final stretched copy pass
+	FJumpFloodCopyTileDrawParams* TileParameters = bUseTileList ? GraphBuilder.AllocParameters<FJumpFloodCopyTileDrawParams>() : nullptr;
+	FJumpFloodCopyPassPS::FParameters* Parameters = bUseTileList ? &TileParameters->PS : GraphBuilder.AllocParameters<FJumpFloodCopyPassPS::FParameters>();
+	if (bPackedSeeds)
+	{
+		Parameters->SeedTexture = Resolve.PrimaryTexture;
+		if (Resolve.bPayload)
+		{
+			Parameters->SeedStencilTexture = Resolve.SeedStencilTexture ? Resolve.SeedStencilTexture : GSystemTextures.GetZeroUIntDummy(GraphBuilder);
+		}
+	}
+	else
+	{
+		Parameters->PrimaryTexture = Resolve.PrimaryTexture;
+		Parameters->SecondaryTexture = Resolve.SecondaryTexture;
+	}
+	Parameters->ViewportMin = Resolve.RenderViewport.Min;
+	Parameters->CopyDestinationResolution = Resolve.RenderViewport.Size();
+	Parameters->MaxDistance = Resolve.MaxDistance;
+	Parameters->TextureSize = TextureSize;
+	Parameters->TextureSizeInverse = FVector2f(1.0f, 1.0f) / TextureSize;
+	Parameters->View = ViewInfo.ViewUniformBuffer;
+	Parameters->SceneTextures = GetSceneTextureParameters(GraphBuilder, ViewInfo);
+
+	FJumpFloodCopyPassPS::FPermutationDomain PermutationVector;
+	PermutationVector.Set<FJumpFloodPackedSeedDim>(bPackedSeeds);
+	PermutationVector.Set<FJumpFloodPayloadDim>(Resolve.bPayload);
+	PermutationVector.Set<FJumpFloodNativeScaleDim>(Resolve.RenderViewport.Size() == Resolve.IntermediateViewport.Size());
+
+	TShaderMapRef<FJumpFloodCopyPassPS> PixelShader(GlobalShaderMap, PermutationVector);
+
+	if (bUseTileList)
+	{
+		//  Only the listed tiles can hold a new result, everything else is either cleared or kept from the previous frame
+		if (Resolve.bClearOutputs)
+		{
+			AddClearRenderTargetPass(GraphBuilder, Resolve.PrimaryRenderTargetTexture, FLinearColor::Transparent, Resolve.RenderViewport);
+			AddClearRenderTargetPass(GraphBuilder, Resolve.SecondaryRenderTargetTexture, FLinearColor::Transparent, Resolve.RenderViewport);
+		}
+
+		Parameters->RenderTargets[0] = FRenderTargetBinding(Resolve.PrimaryRenderTargetTexture, ERenderTargetLoadAction::ELoad);
+		Parameters->RenderTargets[1] = FRenderTargetBinding(Resolve.SecondaryRenderTargetTexture, ERenderTargetLoadAction::ELoad);
+
+		AddTileDrawPass(GraphBuilder, RDG_EVENT_NAME("JumpFlood - Resolve Tiles"), GlobalShaderMap, Resolve.RenderViewport, Resolve.IntermediateViewport, PixelShader, TileParameters, Resolve.TileList);
+	}
+	else
+	{
+		//  Every texel of the view rect is written, and other views' regions of the targets have to be kept
+		Parameters->RenderTargets[0] = FRenderTargetBinding(Resolve.PrimaryRenderTargetTexture, ERenderTargetLoadAction::ELoad);
+		Parameters->RenderTargets[1] = FRenderTargetBinding(Resolve.SecondaryRenderTargetTexture, ERenderTargetLoadAction::ELoad);
+
+		FPixelShaderUtils::AddFullscreenPass(GraphBuilder, GlobalShaderMap, FRDGEventName(TEXT("JumpFlood - Resolve")), PixelShader, Parameters, Resolve.RenderViewport);
+	}
+
+	//  A stereo pair resolves together, but queries are in the primary eye's UV
+	FIntRect FieldViewport = ViewInfo.ViewRect;
+	FieldViewport.Clip(Resolve.RenderViewport);
+	AddFieldQueryPass_RenderThread(GraphBuilder, GlobalShaderMap, ViewInfo, Resolve.PrimaryRenderTargetTexture, Resolve.SecondaryRenderTargetTexture, FieldViewport);
+}
+
+void FJumpFloodPassSceneViewExtension::SubscribeToPostProcessingPass(EPostProcessingPass Pass, FAfterPassCallbackDelegateArray& InOutPassCallbacks, bool bIsPassEnabled)
+{
+	if (Pass == EPostProcessingPass::Tonemap && bIsPassEnabled && IsPublishingField())
+	{
+		InOutPassCallbacks.Add(FAfterPassCallbackDelegate::CreateRaw(this, &FJumpFloodPassSceneViewExtension::PostProcessMaterialPass_RenderThread));
+	}
+}
+
+void FJumpFloodPassSceneViewExtension::PublishField_RenderThread(FRDGBuilder& GraphBuilder, const FViewInfo& ViewInfo, const FJumpFloodResolveOutput& ResolveOutput, float ViewSplit)
+{
+	ResetDeferredWork_RenderThread(GraphBuilder, ViewInfo.Family->FrameNumber);
+
+	const FIntPoint Extent = ResolveOutput.PrimaryTexture->Desc.Extent;
+	if (ViewSplit <= 0.0f)
+	{
+		PublishedFields.Add({ &ViewInfo, ResolveOutput.PrimaryTexture, ResolveOutput.SecondaryTexture, FIntRect(FIntPoint::ZeroValue, Extent) });
+		return;
+	}
+
+	//  Both stereo eyes were flooded side by side, so each gets its half
+	const int32 SplitX = FMath::RoundToInt(ViewSplit);
+	PublishedFields.Add({ &ViewInfo, ResolveOutput.PrimaryTexture, ResolveOutput.SecondaryTexture, FIntRect(0, 0, SplitX, Extent.Y) });
+
+	for (const FSceneView* FamilyView : ViewInfo.Family->Views)
+	{
+		if (FamilyView != &ViewInfo && IStereoRendering::IsASecondaryView(*FamilyView))
+		{
+			PublishedFields.Add({ FamilyView, ResolveOutput.PrimaryTexture, ResolveOutput.SecondaryTexture, FIntRect(SplitX, 0, Extent.X, Extent.Y) });
+		}
+	}
+}
+
+void FJumpFloodPassSceneViewExtension::ResetDeferredWork_RenderThread(const FRDGBuilder& GraphBuilder, uint32 FrameNumber)
+{
+	//  Textures from an earlier graph are gone, even if the builder happens to sit at the same address
+	if (DeferredWorkGraph != &GraphBuilder || DeferredWorkFrameNumber != FrameNumber)
+	{
+		PublishedFields.Reset();
+		DeferredResolves.Reset();
+		DeferredWorkGraph = &GraphBuilder;
+		DeferredWorkFrameNumber = FrameNumber;
+	}
+}
+
+FScreenPassTexture FJumpFloodPassSceneViewExtension::PostProcessMaterialPass_RenderThread(FRDGBuilder& GraphBuilder, const FSceneView& View, const FPostProcessMaterialInputs& InOutInputs)
+{
+	const FJumpFloodPublishedField* Field = DeferredWorkGraph == &GraphBuilder
+		? PublishedFields.FindByPredicate([&View](const FJumpFloodPublishedField& Published) { return Published.View == &View; })
+		: nullptr;
+
+	if (!Field || !IsValid(PostProcessMaterial))
+	{
+		return InOutInputs.ReturnUntouchedSceneColorForPostProcessing(GraphBuilder);
+	}
+
+	checkSlow(View.bIsViewInfo);
+	const FViewInfo& ViewInfo = static_cast<const FViewInfo&>(View);
+
+	FPostProcessMaterialInputs Inputs = InOutInputs;
+	Inputs.SetInput(JumpFloodPrimaryMaterialInput, FScreenPassTexture(Field->PrimaryTexture, Field->Viewport));
+	Inputs.SetInput(JumpFloodSecondaryMaterialInput, FScreenPassTexture(Field->SecondaryTexture, Field->Viewport));
+
+	return AddPostProcessMaterialPass(GraphBuilder, ViewInfo, Inputs, PostProcessMaterial);
+}
+
+void FJumpFloodPassSceneViewExtension::AddSeedPass_RenderThread(
+	FRDGBuilder& GraphBuilder,
+	const FGlobalShaderMap* GlobalShaderMap,
+	const FViewInfo& ViewInfo,
+	const FIntRect& RenderViewport,
+	const FIntRect& IntermediateViewport,
+	const FRDGTextureRef& PrimaryWriteTexture,
+	const FRDGTextureRef& SecondaryWriteTexture,
+	bool bPackedSeeds,
+	const FJumpFloodTileList* TileList)
+{
+	FJumpFloodSeedTileDrawParams* TileParameters = TileList ? GraphBuilder.AllocParameters<FJumpFloodSeedTileDrawParams>() : nullptr;
+	FJumpFloodSeedPassPS::FParameters* Parameters = TileList ? &TileParameters->PS : GraphBuilder.AllocParameters<FJumpFloodSeedPassPS::FParameters>();
+	Parameters->TextureSizeInverse = FVector2f(1.0f, 1.0f) / FVector2f(PrimaryWriteTexture->Desc.Extent);
+	Parameters->ViewportMin = RenderViewport.Min;
+	Parameters->ViewportSize = RenderViewport.Size();
+	Parameters->View = ViewInfo.ViewUniformBuffer;
+	Parameters->SceneTextures = GetSceneTextureParameters(GraphBuilder, ViewInfo);
+
+	// We're going to also clear the render target, unless only some tiles are seeded into an already cleared one
+	const ERenderTargetLoadAction LoadAction = TileList ? ERenderTargetLoadAction::ELoad : ERenderTargetLoadAction::EClear;
+	Parameters->RenderTargets[0] = FRenderTargetBinding(PrimaryWriteTexture, LoadAction);
+	if (SecondaryWriteTexture)
+	{
+		Parameters->RenderTargets[1] = FRenderTargetBinding(SecondaryWriteTexture, LoadAction);
+	}
+
+	FJumpFloodSeedPassPS::FPermutationDomain PermutationVector;
+	PermutationVector.Set<FJumpFloodPackedSeedDim>(bPackedSeeds);
+	PermutationVector.Set<FJumpFloodPayloadDim>(GetPayloadPermutation(SecondaryWriteTexture != nullptr, bPackedSeeds, false));
+	PermutationVector.Set<FJumpFloodNativeScaleDim>(RenderViewport.Size() == IntermediateViewport.Size());
+	PermutationVector.Set<FJumpFloodSeedCrossDim>(CVarJumpFloodSeedEdgeDetection.GetValueOnRenderThread() == 1);
+
+	TShaderMapRef<FJumpFloodSeedPassPS> PixelShader(GlobalShaderMap, PermutationVector);
+
+	if (TileList)
+	{
+		AddTileDrawPass(GraphBuilder, RDG_EVENT_NAME("JumpFlood - Seed Tiles"), GlobalShaderMap, IntermediateViewport, IntermediateViewport, PixelShader, TileParameters, *TileList);
+	}
+	else
+	{
+		FPixelShaderUtils::AddFullscreenPass(GraphBuilder, GlobalShaderMap, FRDGEventName(TEXT("JumpFlood - Seed")), PixelShader, Parameters, IntermediateViewport);
+	}
+}
+
+//  Splits a segment, or a filled rect, into pieces that each cover at most JumpFloodSeedPieceSize texels a side of ClipRect.
+//  Returns how many pieces were dropped for going past JumpFloodMaxSeedPieces
+static int32 AddSeedPieces(
+	const FVector2f& A,
+	const FVector2f& B,
+	float InvDepthA,
+	float InvDepthB,
+	float Radius,
+	uint32 StencilAndFlags,
+	const FIntRect& ClipRect,
+	TArray<FJumpFloodSeedPiece>& OutPieces)
+{
+	const bool bFillBounds = (StencilAndFlags & JumpFloodSeedPieceFillBounds) != 0;
+	int32 DroppedCount = 0;
+	const int32 SplitCount = bFillBounds ? 1 : FMath::Max(FMath::CeilToInt(FVector2f::Distance(A, B) / JumpFloodSeedPieceSize), 1);
+
+	for (int32 Split = 0; Split < SplitCount; ++Split)
+	{
+		const float AlphaA = (float) Split / SplitCount;
+		const float AlphaB = (float) (Split + 1) / SplitCount;
+
+		FJumpFloodSeedPiece Piece;
+		Piece.Radius = Radius;
+		Piece.InvDepthA = FMath::Lerp(InvDepthA, InvDepthB, AlphaA);
+		Piece.InvDepthB = FMath::Lerp(InvDepthA, InvDepthB, AlphaB);
+		Piece.StencilAndFlags = StencilAndFlags;
+
+		const FVector2f PieceA = FMath::Lerp(A, B, AlphaA);
+		const FVector2f PieceB = FMath::Lerp(A, B, AlphaB);
+		Piece.Segment = FVector4f(PieceA.X, PieceA.Y, PieceB.X, PieceB.Y);
+
+		FIntRect Bounds(
+			FMath::FloorToInt(FMath::Min(PieceA.X, PieceB.X) - Radius),
+			FMath::FloorToInt(FMath::Min(PieceA.Y, PieceB.Y) - Radius),
+			FMath::CeilToInt(FMath::Max(PieceA.X, PieceB.X) + Radius),
+			FMath::CeilToInt(FMath::Max(PieceA.Y, PieceB.Y) + Radius));
+		Bounds.Clip(ClipRect);
+
+		//  Wide radii and rects still get split into regions small enough for one group
+		for (int32 Y = Bounds.Min.Y; Y < Bounds.Max.Y; Y += JumpFloodSeedPieceSize)
+		{
+			for (int32 X = Bounds.Min.X; X < Bounds.Max.X; X += JumpFloodSeedPieceSize)
+			{
+				if (OutPieces.Num() >= JumpFloodMaxSeedPieces)
+				{
+					++DroppedCount;
+					continue;
+				}
+
+				Piece.Bounds = FVector4f(X, Y, FMath::Min(X + JumpFloodSeedPieceSize, Bounds.Max.X), FMath::Min(Y + JumpFloodSeedPieceSize, Bounds.Max.Y));
+				OutPieces.Add(Piece);
+			}
+		}
+	}
+
+	return DroppedCount;
+}
+
+void FJumpFloodPassSceneViewExtension::BuildSeedPieces_RenderThread(const FViewInfo& ViewInfo, const FIntRect& RenderViewport, const FIntRect& IntermediateViewport, TArray<FJumpFloodSeedPiece>& OutPieces) const
+{
+	if (SeedSources_RenderThread.Num() == 0)
+	{
+		return;
+	}
+
+	//  Side by side stereo floods both eyes together, so each eye projects the sources into its own half
+	TArray<const FViewInfo*, TInlineAllocator<2>> Views = { &ViewInfo };
+	if (IStereoRendering::IsStereoEyeView(ViewInfo))
+	{
+		for (const FSceneView* FamilyView : ViewInfo.Family->Views)
+		{
+			if (FamilyView != &ViewInfo && IStereoRendering::IsASecondaryView(*FamilyView))
+			{
+				Views.Add(static_cast<const FViewInfo*>(FamilyView));
+			}
+		}
+	}
+
+	const FVector2f RenderToIntermediate = FVector2f(IntermediateViewport.Size()) / FVector2f(RenderViewport.Size());
+
+	int32 DroppedPieceCount = 0;
+
+	for (const FViewInfo* View : Views)
+	{
+		const FIntRect& ViewRect = View->ViewRect;
+		const FIntRect ClipRect(
+			FIntPoint(FMath::FloorToInt((ViewRect.Min.X - RenderViewport.Min.X) * RenderToIntermediate.X), FMath::FloorToInt((ViewRect.Min.Y - RenderViewport.Min.Y) * RenderToIntermediate.Y)).ComponentMax(IntermediateViewport.Min),
+			FIntPoint(FMath::CeilToInt((ViewRect.Max.X - RenderViewport.Min.X) * RenderToIntermediate.X), FMath::CeilToInt((ViewRect.Max.Y - RenderViewport.Min.Y) * RenderToIntermediate.Y)).ComponentMin(IntermediateViewport.Max));
+
+		auto ViewUVToIntermediate = [&](const FVector2D& UV)
+		{
+			const FVector2D RenderPosition = FVector2D(ViewRect.Min) + UV * FVector2D(ViewRect.Size()) - FVector2D(RenderViewport.Min);
+			return FVector2f(RenderPosition) * RenderToIntermediate;
+		};
+
+		//  Jitter is left out, so the seeds hold still under temporal anti-aliasing
+		const FMatrix WorldToClip = View->ViewMatrices.GetViewMatrix() * View->ViewMatrices.GetProjectionNoAAMatrix();
+		const double NearW = FMath::Max((double) View->NearClippingDistance, UE_KINDA_SMALL_NUMBER);
+
+		auto ClipToIntermediate = [&](const FVector4& Clip)
+		{
+			return ViewUVToIntermediate(FVector2D(Clip.X / Clip.W * 0.5 + 0.5, 0.5 - Clip.Y / Clip.W * 0.5));
+		};
+
+		for (const FJumpFloodSeedSource& SeedSource : SeedSources_RenderThread)
+		{
+			//  Even a zero radius has to cover at least one texel centre wherever the segment passes
+			const float Radius = FMath::Max(SeedSource.Radius * RenderToIntermediate.X, UE_HALF_SQRT_2);
+			const uint32 Stencil = FMath::Max<uint32>(SeedSource.StencilId, 1);
+
+			if (SeedSource.Shape == EJumpFloodSeedShape::ScreenRect)
+			{
+				if (SeedSource.Points.Num() >= 2)
+				{
+					const FVector2f Min = ViewUVToIntermediate(FVector2D(SeedSource.Points[0]));
+					const FVector2f Max = ViewUVToIntermediate(FVector2D(SeedSource.Points[1]));
+					DroppedPieceCount += AddSeedPieces(Min.ComponentMin(Max), Min.ComponentMax(Max), 0.0f, 0.0f, 0.0f, Stencil | JumpFloodSeedPieceFillBounds, ClipRect, OutPieces);
+				}
+				continue;
+			}
+
+			if (SeedSource.Shape == EJumpFloodSeedShape::Point)
+			{
+				if (SeedSource.Points.Num() >= 1)
+				{
+					const FVector4 Clip = WorldToClip.TransformFVector4(FVector4(SeedSource.Points[0], 1.0));
+					if (Clip.W >= NearW)
+					{
+						const FVector2f Position = ClipToIntermediate(Clip);
+						const float InvDepth = (float) (1.0 / Clip.W);
+						DroppedPieceCount += AddSeedPieces(Position, Position, InvDepth, InvDepth, Radius, Stencil, ClipRect, OutPieces);
+					}
+				}
+				continue;
+			}
+
+			for (int32 Index = 1; Index < SeedSource.Points.Num(); ++Index)
+			{
+				FVector4 ClipA = WorldToClip.TransformFVector4(FVector4(SeedSource.Points[Index - 1], 1.0));
+				FVector4 ClipB = WorldToClip.TransformFVector4(FVector4(SeedSource.Points[Index], 1.0));
+
+				//  Segments crossing the near plane are cut at it, rather than projecting through the camera
+				if (ClipA.W < NearW && ClipB.W < NearW)
+				{
+					continue;
+				}
+				if (ClipA.W < NearW)
+				{
+					ClipA = ClipA + (ClipB - ClipA) * ((NearW - ClipA.W) / (ClipB.W - ClipA.W));
+				}
+				else if (ClipB.W < NearW)
+				{
+					ClipB = ClipB + (ClipA - ClipB) * ((NearW - ClipB.W) / (ClipA.W - ClipB.W));
+				}
+
+				DroppedPieceCount += AddSeedPieces(ClipToIntermediate(ClipA), ClipToIntermediate(ClipB), (float) (1.0 / ClipA.W), (float) (1.0 / ClipB.W), Radius, Stencil, ClipRect, OutPieces);
+			}
+		}
+	}
+
+	if (DroppedPieceCount > 0)
+	{
+		INC_DWORD_STAT_BY(STAT_JumpFloodSeedPiecesDropped, DroppedPieceCount);
+
+		static bool bWarnedDroppedPieces = false;
+		if (!bWarnedDroppedPieces)
+		{
+			bWarnedDroppedPieces = true;
+			UE_LOG(LogJumpFloodPass, Warning, TEXT("Seed sources split into more than %d pieces in a view, so %d were dropped. Fewer, shorter or thinner seed sources stay within the limit"), JumpFloodMaxSeedPieces, DroppedPieceCount);
+		}
+	}
+}
+
+void FJumpFloodPassSceneViewExtension::AddSeedSourcePass_RenderThread(
+	FRDGBuilder& GraphBuilder,
+	const FGlobalShaderMap* GlobalShaderMap,
+	const TArray<FJumpFloodSeedPiece>& Pieces,
+	const FRDGTextureRef& PrimaryWriteTexture,
+	const FRDGTextureRef& SecondaryWriteTexture,
+	const FRDGTextureRef& SeedStencilTexture,
+	bool bPackedSeeds,
+	int32 GroupMode)
+{
+	const bool bGroupSeeds = GroupMode > 0;
+
+	FJumpFloodSeedSourceCS::FPermutationDomain PermutationVector;
+	PermutationVector.Set<FJumpFloodPackedSeedDim>(bPackedSeeds || bGroupSeeds);
+	PermutationVector.Set<FJumpFloodPayloadDim>(!bGroupSeeds && (bPackedSeeds ? SeedStencilTexture != nullptr : SecondaryWriteTexture != nullptr));
+	PermutationVector.Set<FJumpFloodGroupsDim>(bGroupSeeds);
+
+	TShaderMapRef<FJumpFloodSeedSourceCS> ComputeShader(GlobalShaderMap, PermutationVector);
+
+	//  A dispatch per group over only that group's pieces, each changing only its own channel of the group seeds. One dispatch
+	//  writing whole texels would erase the seeds other groups' pieces left where they overlap
+	if (bGroupSeeds)
+	{
+		for (int32 Group = 0; Group < JumpFloodGroupCount; ++Group)
+		{
+			TArray<FJumpFloodSeedPiece> GroupPieces;
+			for (const FJumpFloodSeedPiece& Piece : Pieces)
+			{
+				if ((GetStencilGroups(Piece.StencilAndFlags & 0xFF, GroupMode) & (1u << Group)) != 0)
+				{
+					GroupPieces.Add(Piece);
+				}
+			}
+
+			if (GroupPieces.Num() == 0)
+			{
+				continue;
+			}
+
+			FJumpFloodSeedSourceCS::FParameters* Parameters = GraphBuilder.AllocParameters<FJumpFloodSeedSourceCS::FParameters>();
+			Parameters->SeedPieces = GraphBuilder.CreateSRV(CreateStructuredBuffer(GraphBuilder, TEXT("JumpFloodSeedPieces"), GroupPieces));
+			Parameters->GroupMode = GroupMode;
+			Parameters->SeedGroup = Group;
+			Parameters->GroupSeedOutputTexture = GraphBuilder.CreateUAV(PrimaryWriteTexture);
+
+			FComputeShaderUtils::AddPass(GraphBuilder, RDG_EVENT_NAME("JumpFlood - Seed Sources (Group %d, %d)", Group, GroupPieces.Num()), ComputeShader, Parameters, FIntVector(GroupPieces.Num(), 1, 1));
+		}
+		return;
+	}
+
+	FJumpFloodSeedSourceCS::FParameters* Parameters = GraphBuilder.AllocParameters<FJumpFloodSeedSourceCS::FParameters>();
+	Parameters->SeedPieces = GraphBuilder.CreateSRV(CreateStructuredBuffer(GraphBuilder, TEXT("JumpFloodSeedPieces"), Pieces));
+	if (bPackedSeeds)
+	{
+		Parameters->SeedOutputTexture = GraphBuilder.CreateUAV(PrimaryWriteTexture);
+		if (SeedStencilTexture)
+		{
+			Parameters->SeedStencilOutputTexture = GraphBuilder.CreateUAV(SeedStencilTexture);
+		}
+	}
+	else
+	{
+		Parameters->PrimaryOutputTexture = GraphBuilder.CreateUAV(PrimaryWriteTexture);
+		if (SecondaryWriteTexture)
+		{
+			Parameters->SecondaryOutputTexture = GraphBuilder.CreateUAV(SecondaryWriteTexture);
+		}
+	}
+
+	FComputeShaderUtils::AddPass(GraphBuilder, RDG_EVENT_NAME("JumpFlood - Seed Sources (%d)", Pieces.Num()), ComputeShader, Parameters, FIntVector(Pieces.Num(), 1, 1));
+}
+
+void FJumpFloodPassSceneViewExtension::AddFloodPass_RenderThread(
+	FRDGBuilder& GraphBuilder,
+	const FGlobalShaderMap* GlobalShaderMap,
+	const FViewInfo& ViewInfo,
+	const FIntRect& IntermediateViewport,
+	const FRDGTextureRef& PrimaryReadTexture,
+	const FRDGTextureRef& PrimaryWriteTexture,
+	const FRDGTextureRef& SecondaryReadTexture,
+	const FRDGTextureRef& SecondaryWriteTexture,
+	bool bPackedSeeds,
+	int32 FloodExponent,
+	float ViewSplit,
+	float ExponentToUVScaler,
+	const FJumpFloodResolveOutput* ResolveOutput)
+{
+	const float FloodStepSize = (float) (1 << FloodExponent);
+
+	//  Only the resolving step reads the scene, so it is a shader of its own
+	if (ResolveOutput)
+	{
+		FJumpFloodFloodResolvePS::FParameters* Parameters = GraphBuilder.AllocParameters<FJumpFloodFloodResolvePS::FParameters>();
+		Parameters->Flood.ViewSplit = ViewSplit;
+		Parameters->FloodStepSize = FloodStepSize;
+		Parameters->SeedSpaceScale = 1.0f;
+		SetFloodReadTextures(Parameters->Flood, PrimaryReadTexture, SecondaryReadTexture, bPackedSeeds);
+		SetResolveStepParameters(GraphBuilder, Parameters->Resolve, ViewInfo, *ResolveOutput, PrimaryReadTexture->Desc.Extent, bPackedSeeds);
+		Parameters->RenderTargets[0] = FRenderTargetBinding(ResolveOutput->PrimaryTexture, ERenderTargetLoadAction::ENoAction);
+		Parameters->RenderTargets[1] = FRenderTargetBinding(ResolveOutput->SecondaryTexture, ERenderTargetLoadAction::ENoAction);
+
+		FJumpFloodFloodResolvePS::FPermutationDomain PermutationVector;
+		PermutationVector.Set<FJumpFloodPackedSeedDim>(bPackedSeeds);
+		PermutationVector.Set<FJumpFloodPayloadDim>(ResolveOutput->bPayload);
+
+		TShaderMapRef<FJumpFloodFloodResolvePS> PixelShader(GlobalShaderMap, PermutationVector);
+		FPixelShaderUtils::AddFullscreenPass(GraphBuilder, GlobalShaderMap, FRDGEventName(TEXT("JumpFlood - Flood (%d)"), (1 << FloodExponent)), PixelShader, Parameters, IntermediateViewport);
+		return;
+	}
+
+	FJumpFloodFloodPassPS::FParameters* Parameters = GraphBuilder.AllocParameters<FJumpFloodFloodPassPS::FParameters>();
+	Parameters->Flood.ViewSplit = ViewSplit;
+	Parameters->FloodStepSize = FloodStepSize;
+	Parameters->SeedSpaceScale = 1.0f;
+	SetFloodReadTextures(Parameters->Flood, PrimaryReadTexture, SecondaryReadTexture, bPackedSeeds);
+
+	if (bPackedSeeds)
+	{
+		Parameters->RenderTargets[0] = FRenderTargetBinding(PrimaryWriteTexture, ERenderTargetLoadAction::ENoAction);
+	}
+	else
+	{
+		Parameters->RenderTargets[0] = FRenderTargetBinding(PrimaryWriteTexture, ERenderTargetLoadAction::ELoad);
+		if (SecondaryWriteTexture)
+		{
+			Parameters->RenderTargets[1] = FRenderTargetBinding(SecondaryWriteTexture, ERenderTargetLoadAction::ELoad);
+		}
+	}
+
+	//  Unpacked intermediates only carry a Secondary texture when there is a payload to resolve
+	const bool bPayload = SecondaryReadTexture != nullptr;
+
+	FJumpFloodFloodPassPS::FPermutationDomain PermutationVector;
+	PermutationVector.Set<FJumpFloodPackedSeedDim>(bPackedSeeds);
+	PermutationVector.Set<FJumpFloodPayloadDim>(GetPayloadPermutation(bPayload, bPackedSeeds, false));
+
+	TShaderMapRef<FJumpFloodFloodPassPS> PixelShader(GlobalShaderMap, PermutationVector);
+	FPixelShaderUtils::AddFullscreenPass(GraphBuilder, GlobalShaderMap, FRDGEventName(TEXT("JumpFlood - Flood (%d)"), (1 << FloodExponent)), PixelShader, Parameters, IntermediateViewport);
+}
+
+void FJumpFloodPassSceneViewExtension::AddFloodComputePass_RenderThread(
+	FRDGBuilder& GraphBuilder,
+	const FGlobalShaderMap* GlobalShaderMap,
+	const FIntRect& IntermediateViewport,
+	const FRDGTextureRef& PrimaryReadTexture,
+	const FRDGTextureRef& PrimaryWriteTexture,
+	const FRDGTextureRef& SecondaryReadTexture,
+	const FRDGTextureRef& SecondaryWriteTexture,
+	bool bPackedSeeds,
+	int32 FloodExponent,
+	float SeedSpaceScale,
+	float ViewSplit,
+	ERDGPassFlags PassFlags,
+	const FJumpFloodTileList* TileList,
+	const FJumpFloodResolveOutput* ResolveOutput)
+{
+	const float FloodStepSize = (float) (1 << FloodExponent);
+
+	if (ResolveOutput)
+	{
+		FJumpFloodFloodResolveCS::FParameters* Parameters = GraphBuilder.AllocParameters<FJumpFloodFloodResolveCS::FParameters>();
+		Parameters->TextureSize = PrimaryReadTexture->Desc.Extent;
+		Parameters->Flood.ViewSplit = ViewSplit;
+		Parameters->FloodStepSize = FloodStepSize;
+		Parameters->SeedSpaceScale = SeedSpaceScale;
+		SetFloodComputeResolveOutput(GraphBuilder, Parameters, *ResolveOutput, PrimaryReadTexture, SecondaryReadTexture, bPackedSeeds);
+
+		FJumpFloodFloodResolveCS::FPermutationDomain PermutationVector;
+		PermutationVector.Set<FJumpFloodPackedSeedDim>(bPackedSeeds);
+		PermutationVector.Set<FJumpFloodTileListDim>(TileList != nullptr);
+		PermutationVector.Set<FJumpFloodPayloadDim>(ResolveOutput->bPayload);
+
+		TShaderMapRef<FJumpFloodFloodResolveCS> ComputeShader(GlobalShaderMap, PermutationVector);
+		AddFloodComputeDispatch(GraphBuilder, FRDGEventName(TEXT("JumpFlood - Flood CS (%d)"), (1 << FloodExponent)), ComputeShader, Parameters, PassFlags, IntermediateViewport, TileList);
+		return;
+	}
+
+	FJumpFloodFloodPassCS::FParameters* Parameters = GraphBuilder.AllocParameters<FJumpFloodFloodPassCS::FParameters>();
+	Parameters->TextureSize = PrimaryReadTexture->Desc.Extent;
+	Parameters->Flood.ViewSplit = ViewSplit;
+	Parameters->FloodStepSize = FloodStepSize;
+	Parameters->SeedSpaceScale = SeedSpaceScale;
+	SetFloodComputeTextures(GraphBuilder, Parameters, PrimaryReadTexture, PrimaryWriteTexture, SecondaryReadTexture, SecondaryWriteTexture, bPackedSeeds);
+
+	const bool bPayload = SecondaryReadTexture != nullptr;
+
+	FJumpFloodFloodPassCS::FPermutationDomain PermutationVector;
+	PermutationVector.Set<FJumpFloodPackedSeedDim>(bPackedSeeds);
+	PermutationVector.Set<FJumpFloodTileListDim>(TileList != nullptr);
+	PermutationVector.Set<FJumpFloodPayloadDim>(GetPayloadPermutation(bPayload, bPackedSeeds, false));
+
+	TShaderMapRef<FJumpFloodFloodPassCS> ComputeShader(GlobalShaderMap, PermutationVector);
+	AddFloodComputeDispatch(GraphBuilder, FRDGEventName(TEXT("JumpFlood - Flood CS (%d)"), (1 << FloodExponent)), ComputeShader, Parameters, PassFlags, IntermediateViewport, TileList);
+}
+
+void FJumpFloodPassSceneViewExtension::AddHierarchicalFloodPasses_RenderThread(
+	FRDGBuilder& GraphBuilder,
+	const FGlobalShaderMap* GlobalShaderMap,
+	const FIntRect& IntermediateViewport,
+	const FRDGTextureRef& SeedTexture,
+	const FRDGTextureRef& OutputTexture,
+	int32 LevelCount,
+	int32 FloodPassCount,
+	float ViewSplit,
+	ERDGPassFlags PassFlags)
+{
+	const int32 Factor = 1 << LevelCount;
+	RDG_EVENT_SCOPE(GraphBuilder, "JumpFlood - Hierarchical Flood (1/%d)", Factor);
+
+	//  Every level keeps full resolution seed coordinates, only the texels they are stored in get coarser
+	FRDGTextureDesc LevelDesc = SeedTexture->Desc;
+	FRDGTextureRef LevelTexture = SeedTexture;
+
+	TShaderMapRef<FJumpFloodReduceSeedsCS> ReduceShader(GlobalShaderMap);
+	for (int32 Level = 1; Level <= LevelCount; ++Level)
+	{
+		LevelDesc.Extent = FIntPoint::DivideAndRoundUp(LevelDesc.Extent, 2);
+		FRDGTextureRef ReducedTexture = GraphBuilder.CreateTexture(LevelDesc, TEXT("JumpFloodSeedLevel"));
+
+		FJumpFloodReduceSeedsCS::FParameters* Parameters = GraphBuilder.AllocParameters<FJumpFloodReduceSeedsCS::FParameters>();
+		Parameters->TextureSize = LevelDesc.Extent;
+		Parameters->SeedSpaceScale = (float) (1 << Level);
+		Parameters->ViewSplit = ViewSplit;
+		Parameters->SeedTexture = LevelTexture;
+		Parameters->SeedOutputTexture = GraphBuilder.CreateUAV(ReducedTexture);
+
+		FComputeShaderUtils::AddPass(
+			GraphBuilder,
+			RDG_EVENT_NAME("JumpFlood - Reduce Seeds (1/%d)", 1 << Level),
+			PassFlags,
+			ReduceShader,
+			Parameters,
+			FComputeShaderUtils::GetGroupCount(LevelDesc.Extent, JumpFloodTileSize));
+
+		LevelTexture = ReducedTexture;
+	}
+
+	//  Same 1+JFA as the full resolution chain, with each step covering Factor times the distance
+	const FIntRect CoarseViewport(FIntPoint::ZeroValue, LevelDesc.Extent);
+	FRDGTextureRef CoarseTextures[] = { LevelTexture, GraphBuilder.CreateTexture(LevelDesc, TEXT("JumpFloodSeedLevel")) };
+	int32 ReadIndex = 1;
+	int32 WriteIndex = 0;
+
+	const int32 CoarseFloodPassCount = FMath::Max(FloodPassCount - LevelCount, 0);
+	for (int32 FloodExponent = CoarseFloodPassCount + 1; FloodExponent >= 0; FloodExponent -= 1)
+	{
+		Swap(ReadIndex, WriteIndex);
+		AddFloodComputePass_RenderThread(
+			GraphBuilder,
+			GlobalShaderMap,
+			CoarseViewport,
+			CoarseTextures[ReadIndex],
+			CoarseTextures[WriteIndex],
+			nullptr,
+			nullptr,
+			true,
+			FloodExponent > CoarseFloodPassCount ? 0 : FloodExponent,
+			(float) Factor,
+			ViewSplit,
+			PassFlags);
+	}
+
+	FJumpFloodUpsampleSeedsCS::FParameters* Parameters = GraphBuilder.AllocParameters<FJumpFloodUpsampleSeedsCS::FParameters>();
+	Parameters->TextureSize = SeedTexture->Desc.Extent;
+	Parameters->SeedSpaceScale = (float) Factor;
+	Parameters->ViewSplit = ViewSplit;
+	Parameters->SeedTexture = SeedTexture;
+	Parameters->CoarseSeedTexture = CoarseTextures[WriteIndex];
+	Parameters->SeedOutputTexture = GraphBuilder.CreateUAV(OutputTexture);
+
+	TShaderMapRef<FJumpFloodUpsampleSeedsCS> UpsampleShader(GlobalShaderMap);
+	FComputeShaderUtils::AddPass(
+		GraphBuilder,
+		RDG_EVENT_NAME("JumpFlood - Upsample Seeds"),
+		PassFlags,
+		UpsampleShader,
+		Parameters,
+		FComputeShaderUtils::GetGroupCount(IntermediateViewport.Max, JumpFloodTileSize));
+}
+
+void FJumpFloodPassSceneViewExtension::AddExactFloodPasses_RenderThread(
+	FRDGBuilder& GraphBuilder,
+	const FGlobalShaderMap* GlobalShaderMap,
+	const FRDGTextureRef& SeedTexture,
+	const FRDGTextureRef& OutputTexture,
+	float ViewSplit,
+	ERDGPassFlags PassFlags)
+{
+	RDG_EVENT_SCOPE(GraphBuilder, "JumpFlood - Exact Flood");
+
+	const FIntPoint Extent = SeedTexture->Desc.Extent;
+
+	//  Texel coordinates are compared as integers, which overflow past this size
+	check(Extent.X <= 16384 && Extent.Y <= 16384);
+
+	//  Rows go into their own texture, for the columns to link their envelopes through and the search to read from
+	FRDGTextureRef SiteTexture = GraphBuilder.CreateTexture(SeedTexture->Desc, TEXT("JumpFloodExactSites"));
+	FRDGTextureRef LinkTexture = GraphBuilder.CreateTexture(
+		FRDGTextureDesc::Create2D(Extent, PF_R32_UINT, FClearValueBinding::Black, TexCreate_ShaderResource | TexCreate_UAV),
+		TEXT("JumpFloodExactLinks"));
+	FRDGTextureRef BandTexture = GraphBuilder.CreateTexture(
+		FRDGTextureDesc::Create2D(FIntPoint(Extent.X, JumpFloodExactBandCount), PF_R32_UINT, FClearValueBinding::Black, TexCreate_ShaderResource | TexCreate_UAV),
+		TEXT("JumpFloodExactBands"));
+	FRDGTextureRef AnchorTexture = GraphBuilder.CreateTexture(
+		FRDGTextureDesc::Create2D(FIntPoint(Extent.X, JumpFloodExactBandCount + 1), PF_R32_UINT, FClearValueBinding::Black, TexCreate_ShaderResource | TexCreate_UAV),
+		TEXT("JumpFloodExactAnchors"));
+
+	AddTextureMemoryStats(
+		2 * GetTextureMemoryKB(Extent, PF_R32_UINT)
+			+ GetTextureMemoryKB(FIntPoint(Extent.X, 2 * JumpFloodExactBandCount + 1), PF_R32_UINT),
+		0);
+
+	const int32 LineGroupSize = JumpFloodTileSize * JumpFloodTileSize;
+
+	{
+		FJumpFloodExactRowsCS::FParameters* Parameters = GraphBuilder.AllocParameters<FJumpFloodExactRowsCS::FParameters>();
+		Parameters->TextureSize = Extent;
+		Parameters->ViewSplit = ViewSplit;
+		Parameters->SeedTexture = SeedTexture;
+		Parameters->SeedOutputTexture = GraphBuilder.CreateUAV(SiteTexture);
+
+		//  A group per row, each of its threads scanning a band of the row
+		TShaderMapRef<FJumpFloodExactRowsCS> ComputeShader(GlobalShaderMap);
+		FComputeShaderUtils::AddPass(
+			GraphBuilder,
+			RDG_EVENT_NAME("JumpFlood - Exact Rows"),
+			PassFlags,
+			ComputeShader,
+			Parameters,
+			FIntVector(Extent.Y, 1, 1));
+	}
+
+	{
+		FJumpFloodExactColumnBandsCS::FParameters* Parameters = GraphBuilder.AllocParameters<FJumpFloodExactColumnBandsCS::FParameters>();
+		Parameters->TextureSize = Extent;
+		Parameters->SeedTexture = SiteTexture;
+		Parameters->ExactLinkOutputTexture = GraphBuilder.CreateUAV(LinkTexture);
+		Parameters->ExactBandOutputTexture = GraphBuilder.CreateUAV(BandTexture);
+
+		TShaderMapRef<FJumpFloodExactColumnBandsCS> ComputeShader(GlobalShaderMap);
+		FComputeShaderUtils::AddPass(
+			GraphBuilder,
+			RDG_EVENT_NAME("JumpFlood - Exact Column Bands"),
+			PassFlags,
+			ComputeShader,
+			Parameters,
+			FComputeShaderUtils::GetGroupCount(FIntPoint(Extent.X, JumpFloodExactBandCount), FIntPoint(LineGroupSize, 1)));
+	}
+
+	{
+		FJumpFloodExactColumnMergeCS::FParameters* Parameters = GraphBuilder.AllocParameters<FJumpFloodExactColumnMergeCS::FParameters>();
+		Parameters->TextureSize = Extent;
+		Parameters->SeedTexture = SiteTexture;
+		Parameters->ExactBandTexture = BandTexture;
+		Parameters->ExactLinkOutputTexture = GraphBuilder.CreateUAV(LinkTexture);
+		Parameters->ExactAnchorOutputTexture = GraphBuilder.CreateUAV(AnchorTexture);
+
+		TShaderMapRef<FJumpFloodExactColumnMergeCS> ComputeShader(GlobalShaderMap);
+		FComputeShaderUtils::AddPass(
+			GraphBuilder,
+			RDG_EVENT_NAME("JumpFlood - Exact Column Merge"),
+			PassFlags,
+			ComputeShader,
+			Parameters,
+			FComputeShaderUtils::GetGroupCount(Extent.X, LineGroupSize));
+	}
+
+	{
+		FJumpFloodExactNearestCS::FParameters* Parameters = GraphBuilder.AllocParameters<FJumpFloodExactNearestCS::FParameters>();
+		Parameters->TextureSize = Extent;
+		Parameters->SeedTexture = SiteTexture;
+		Parameters->ExactLinkTexture = LinkTexture;
+		Parameters->ExactAnchorTexture = AnchorTexture;
+		Parameters->SeedOutputTexture = GraphBuilder.CreateUAV(OutputTexture);
+
+		TShaderMapRef<FJumpFloodExactNearestCS> ComputeShader(GlobalShaderMap);
+		FComputeShaderUtils::AddPass(
+			GraphBuilder,
+			RDG_EVENT_NAME("JumpFlood - Exact Nearest"),
+			PassFlags,
+			ComputeShader,
+			Parameters,
+			FComputeShaderUtils::GetGroupCount(FIntPoint(Extent.X, JumpFloodExactBandCount), FIntPoint(LineGroupSize, 1)));
+	}
+}
+
+FRDGTextureRef FJumpFloodPassSceneViewExtension::AddAmortizedFloodPasses_RenderThread(
+	FRDGBuilder& GraphBuilder,
+	const FGlobalShaderMap* GlobalShaderMap,
+	const FViewInfo& ViewInfo,
+	FJumpFloodAmortizedFlood& Amortized,
+	const FIntRect& RenderViewport,
+	const FIntRect& IntermediateViewport,
+	bool bStencilSeeds,
+	int32 FrameCount,
+	int32 FloodPassCount,
+	int32 RefinementPassCount,
+	float MaxDistance,
+	ERDGPassFlags PassFlags)
+{
+	RDG_EVENT_SCOPE(GraphBuilder, "JumpFlood - Amortized Flood");
+
+	const FIntPoint Extent = IntermediateViewport.Size();
+
+	//  Jitter is left out, it would only shake the reprojected seeds
+	const FMatrix ViewProjectionMatrix = ViewInfo.ViewMatrices.GetViewMatrix() * ViewInfo.ViewMatrices.GetProjectionNoAAMatrix();
+
+	//  Anything the floods no longer match starts over, flooding in full within this frame
+	if (Amortized.Extent != Extent || Amortized.MaxDistance != MaxDistance || Amortized.FrameCount != FrameCount || ViewInfo.bCameraCut)
+	{
+		if (Amortized.Extent != Extent)
+		{
+			const FRDGTextureDesc SeedDesc = FRDGTextureDesc::Create2D(Extent, PF_R32_UINT, FClearValueBinding::Black, TexCreate_RenderTargetable | TexCreate_ShaderResource | TexCreate_UAV);
+			for (TRefCountPtr<IPooledRenderTarget>& SeedTexture : Amortized.SeedTextures)
+			{
+				SeedTexture = AllocatePooledTexture(SeedDesc, TEXT("JumpFloodAmortizedSeeds"));
+			}
+
+			const FRDGTextureDesc DepthDesc = FRDGTextureDesc::Create2D(Extent, PF_R32_FLOAT, FClearValueBinding::Black, TexCreate_ShaderResource | TexCreate_UAV);
+			for (TRefCountPtr<IPooledRenderTarget>& DepthTexture : Amortized.DepthTextures)
+			{
+				DepthTexture = AllocatePooledTexture(DepthDesc, TEXT("JumpFloodAmortizedSeedDepth"));
+			}
+		}
+
+		Amortized.Extent = Extent;
+		Amortized.MaxDistance = MaxDistance;
+		Amortized.FrameCount = FrameCount;
+		Amortized.CompletedIndex = INDEX_NONE;
+		Amortized.NextStep = 0;
+	}
+	else if (Amortized.FloodPassCount != FloodPassCount || Amortized.RefinementPassCount != RefinementPassCount)
+	{
+		//  The cascade in progress was laid out for other steps, so it starts over while the completed flood is still shown
+		Amortized.NextStep = 0;
+	}
+
+	Amortized.FloodPassCount = FloodPassCount;
+	Amortized.RefinementPassCount = RefinementPassCount;
+
+	AddTextureMemoryStats(
+		GetTextureMemoryKB(Extent, PF_R32_UINT),
+		GetTextureMemoryKB(Extent, PF_R32_UINT) * UE_ARRAY_COUNT(Amortized.SeedTextures) + GetTextureMemoryKB(Extent, PF_R32_FLOAT) * UE_ARRAY_COUNT(Amortized.DepthTextures));
+
+	FRDGTextureRef SeedTextures[UE_ARRAY_COUNT(Amortized.SeedTextures)];
+	for (int32 Index = 0; Index < UE_ARRAY_COUNT(Amortized.SeedTextures); ++Index)
+	{
+		SeedTextures[Index] = GraphBuilder.RegisterExternalTexture(Amortized.SeedTextures[Index], TEXT("JumpFloodAmortizedSeeds"));
+	}
+
+	//  The flood in progress ping-pongs between whichever two seed textures the completed flood isn't in
+	const auto GetFreeIndex = [&Amortized](int32 UsedIndex)
+	{
+		for (int32 Index = 0; Index < UE_ARRAY_COUNT(Amortized.SeedTextures); ++Index)
+		{
+			if (Index != UsedIndex && Index != Amortized.CompletedIndex)
+			{
+				return Index;
+			}
+		}
+		return INDEX_NONE;
+	};
+
+	const FSceneTextureShaderParameters SceneTextures = GetSceneTextureParameters(GraphBuilder, ViewInfo);
+	const FIntVector GroupCount = FComputeShaderUtils::GetGroupCount(Extent, JumpFloodTileSize);
+
+	if (Amortized.NextStep == 0)
+	{
+		Amortized.LatestIndex = GetFreeIndex(INDEX_NONE);
+		Amortized.DepthIndex = Amortized.CompletedIndex == INDEX_NONE ? 0 : 1 - Amortized.CompletedDepthIndex;
+		Amortized.ViewProjectionMatrix = ViewProjectionMatrix;
+
+		FRDGTextureRef SeedTexture = SeedTextures[Amortized.LatestIndex];
+		if (bStencilSeeds)
+		{
+			AddSeedPass_RenderThread(GraphBuilder, GlobalShaderMap, ViewInfo, RenderViewport, IntermediateViewport, SeedTexture, nullptr, true, nullptr);
+		}
+		else
+		{
+			AddClearRenderTargetPass(GraphBuilder, SeedTexture);
+		}
+
+		FJumpFloodCaptureSeedDepthCS::FParameters* Parameters = GraphBuilder.AllocParameters<FJumpFloodCaptureSeedDepthCS::FParameters>();
+		Parameters->View = ViewInfo.ViewUniformBuffer;
+		Parameters->SceneTextures = SceneTextures;
+		Parameters->ViewportMin = FVector2f(RenderViewport.Min);
+		Parameters->ViewportSize = FVector2f(RenderViewport.Size());
+		Parameters->TextureSize = Extent;
+		Parameters->TextureSizeInverse = FVector2f(1.0f, 1.0f) / FVector2f(Extent);
+		Parameters->SeedDeviceZOutputTexture = GraphBuilder.CreateUAV(GraphBuilder.RegisterExternalTexture(Amortized.DepthTextures[Amortized.DepthIndex], TEXT("JumpFloodAmortizedSeedDepth")));
+
+		TShaderMapRef<FJumpFloodCaptureSeedDepthCS> ComputeShader(GlobalShaderMap);
+		FComputeShaderUtils::AddPass(GraphBuilder, RDG_EVENT_NAME("JumpFlood - Capture Seed Depth"), ComputeShader, Parameters, GroupCount);
+	}
+
+	//  The same 1+JFA cascade as a single frame's flood, with INDEX_NONE standing in for the tile pass's small steps
+	TArray<int32, TInlineAllocator<32>> Steps;
+	Steps.Add(0);
+
+	const int32 TileExponent = FMath::FloorLog2(JumpFloodTileSize);
+	for (int32 FloodExponent = FloodPassCount; FloodExponent >= TileExponent; FloodExponent -= 1)
+	{
+		Steps.Add(FloodExponent);
+	}
+
+	Steps.Add(INDEX_NONE);
+
+	for (int32 FloodExponent = RefinementPassCount - 1; FloodExponent > -1; FloodExponent -= 1)
+	{
+		Steps.Add(FloodExponent);
+	}
+
+	//  Until a flood has completed there is nothing to show, so the first runs every step at once
+	const int32 FrameStepCount = Amortized.CompletedIndex == INDEX_NONE ? Steps.Num() : FMath::DivideAndRoundUp(Steps.Num(), FrameCount);
+	const int32 LastStep = FMath::Min(Amortized.NextStep + FrameStepCount, Steps.Num());
+
+	for (int32 Step = Amortized.NextStep; Step < LastStep; ++Step)
+	{
+		const int32 ReadIndex = Amortized.LatestIndex;
+		const int32 WriteIndex = GetFreeIndex(ReadIndex);
+
+		if (Steps[Step] == INDEX_NONE)
+		{
+			AddFloodTilePass_RenderThread(
+				GraphBuilder,
+				GlobalShaderMap,
+				IntermediateViewport,
+				SeedTextures[ReadIndex],
+				SeedTextures[WriteIndex],
+				nullptr,
+				nullptr,
+				true,
+				0.0f,
+				PassFlags,
+				nullptr,
+				nullptr);
+		}
+		else
+		{
+			AddFloodComputePass_RenderThread(
+				GraphBuilder,
+				GlobalShaderMap,
+				IntermediateViewport,
+				SeedTextures[ReadIndex],
+				SeedTextures[WriteIndex],
+				nullptr,
+				nullptr,
+				true,
+				Steps[Step],
+				1.0f,
+				0.0f,
+				PassFlags);
+		}
+
+		Amortized.LatestIndex = WriteIndex;
+	}
+
+	Amortized.NextStep = LastStep;
+	if (Amortized.NextStep >= Steps.Num())
+	{
+		Amortized.CompletedIndex = Amortized.LatestIndex;
+		Amortized.CompletedDepthIndex = Amortized.DepthIndex;
+		Amortized.CompletedViewProjectionMatrix = Amortized.ViewProjectionMatrix;
+		Amortized.NextStep = 0;
+	}
+
+	//  The completed flood, moved by the camera's motion since its seeds were taken
+	FRDGTextureRef ReprojectedTexture = GraphBuilder.CreateTexture(SeedTextures[0]->Desc, TEXT("JumpFloodReprojectedSeeds"));
+
+	FJumpFloodReprojectSeedsCS::FParameters* Parameters = GraphBuilder.AllocParameters<FJumpFloodReprojectSeedsCS::FParameters>();
+	Parameters->TextureSize = Extent;
+	Parameters->TextureSizeInverse = FVector2f(1.0f, 1.0f) / FVector2f(Extent);
+	Parameters->SeedClipToClip = FMatrix44f(Amortized.CompletedViewProjectionMatrix.Inverse() * ViewProjectionMatrix);
+	Parameters->SeedTexture = SeedTextures[Amortized.CompletedIndex];
+	Parameters->SeedDeviceZTexture = GraphBuilder.RegisterExternalTexture(Amortized.DepthTextures[Amortized.CompletedDepthIndex], TEXT("JumpFloodAmortizedSeedDepth"));
+	Parameters->SeedOutputTexture = GraphBuilder.CreateUAV(ReprojectedTexture);
+
+	TShaderMapRef<FJumpFloodReprojectSeedsCS> ComputeShader(GlobalShaderMap);
+	FComputeShaderUtils::AddPass(GraphBuilder, RDG_EVENT_NAME("JumpFlood - Reproject Seeds"), PassFlags, ComputeShader, Parameters, GroupCount);
+
+	return ReprojectedTexture;
+}
+
+void FJumpFloodPassSceneViewExtension::AddFloodTilePass_RenderThread(
+	FRDGBuilder& GraphBuilder,
+	const FGlobalShaderMap* GlobalShaderMap,
+	const FIntRect& IntermediateViewport,
+	const FRDGTextureRef& PrimaryReadTexture,
+	const FRDGTextureRef& PrimaryWriteTexture,
+	const FRDGTextureRef& SecondaryReadTexture,
+	const FRDGTextureRef& SecondaryWriteTexture,
+	bool bPackedSeeds,
+	float ViewSplit,
+	ERDGPassFlags PassFlags,
+	const FJumpFloodTileList* TileList,
+	const FJumpFloodResolveOutput* ResolveOutput)
+{
+	if (ResolveOutput)
+	{
+		FJumpFloodFloodTileResolveCS::FParameters* Parameters = GraphBuilder.AllocParameters<FJumpFloodFloodTileResolveCS::FParameters>();
+		Parameters->TextureSize = PrimaryReadTexture->Desc.Extent;
+		Parameters->Flood.ViewSplit = ViewSplit;
+		SetFloodComputeResolveOutput(GraphBuilder, Parameters, *ResolveOutput, PrimaryReadTexture, SecondaryReadTexture, bPackedSeeds);
+
+		FJumpFloodFloodTileResolveCS::FPermutationDomain PermutationVector;
+		PermutationVector.Set<FJumpFloodPackedSeedDim>(bPackedSeeds);
+		PermutationVector.Set<FJumpFloodTileListDim>(TileList != nullptr);
+		PermutationVector.Set<FJumpFloodPayloadDim>(ResolveOutput->bPayload);
+
+		TShaderMapRef<FJumpFloodFloodTileResolveCS> ComputeShader(GlobalShaderMap, PermutationVector);
+		AddFloodComputeDispatch(GraphBuilder, FRDGEventName(TEXT("JumpFlood - Flood Tile CS (%d-1)"), JumpFloodTileSize / 2), ComputeShader, Parameters, PassFlags, IntermediateViewport, TileList);
+		return;
+	}
+
+	FJumpFloodFloodTilePassCS::FParameters* Parameters = GraphBuilder.AllocParameters<FJumpFloodFloodTilePassCS::FParameters>();
+	Parameters->TextureSize = PrimaryReadTexture->Desc.Extent;
+	Parameters->Flood.ViewSplit = ViewSplit;
+	SetFloodComputeTextures(GraphBuilder, Parameters, PrimaryReadTexture, PrimaryWriteTexture, SecondaryReadTexture, SecondaryWriteTexture, bPackedSeeds);
+
+	const bool bPayload = SecondaryReadTexture != nullptr;
+
+	FJumpFloodFloodTilePassCS::FPermutationDomain PermutationVector;
+	PermutationVector.Set<FJumpFloodPackedSeedDim>(bPackedSeeds);
+	PermutationVector.Set<FJumpFloodTileListDim>(TileList != nullptr);
+	PermutationVector.Set<FJumpFloodPayloadDim>(GetPayloadPermutation(bPayload, bPackedSeeds, false));
+
+	TShaderMapRef<FJumpFloodFloodTilePassCS> ComputeShader(GlobalShaderMap, PermutationVector);
+	AddFloodComputeDispatch(GraphBuilder, FRDGEventName(TEXT("JumpFlood - Flood Tile CS (%d-1)"), JumpFloodTileSize / 2), ComputeShader, Parameters, PassFlags, IntermediateViewport, TileList);
+}
+
+//  Per tile flags, along with a single flag that is set when any tile is
+static FJumpFloodTileMask CreateTileMask(FRDGBuilder& GraphBuilder, const FIntPoint& TileCount, const TCHAR* Name, FRDGBufferUAVRef& OutAnyTileUAV)
+{
+	FRDGBufferRef AnyTileBuffer = GraphBuilder.CreateBuffer(FRDGBufferDesc::CreateBufferDesc(sizeof(uint32), 1), TEXT("JumpFloodAnyTile"));
+
+	OutAnyTileUAV = GraphBuilder.CreateUAV(AnyTileBuffer, PF_R32_UINT);
+	AddClearUAVPass(GraphBuilder, OutAnyTileUAV, 0);
+
+	FJumpFloodTileMask TileMask;
+	TileMask.Tiles = GraphBuilder.CreateTexture(FRDGTextureDesc::Create2D(TileCount, PF_R8_UINT, FClearValueBinding::None, TexCreate_ShaderResource | TexCreate_UAV), Name);
+	TileMask.AnyTile = GraphBuilder.CreateSRV(AnyTileBuffer, PF_R32_UINT);
+	return TileMask;
+}
+
+void FJumpFloodPassSceneViewExtension::AddGroupFloodPasses_RenderThread(
+	FRDGBuilder& GraphBuilder,
 	const FGlobalShaderMap* GlobalShaderMap,
 	const FViewInfo& ViewInfo,
+	const FIntRect& RenderViewport,
 	const FIntRect& IntermediateViewport,
-	const FRDGTextureRef& PrimaryReadTexture,
-	const FRDGTextureRef& PrimaryWriteTexture,
-	const FRDGTextureRef& SecondaryReadTexture,
-	const FRDGTextureRef& SecondaryWriteTexture,
-	int32 FloodExponent,
-	float ExponentToUVScaler)
+	const TArray<FJumpFloodSeedPiece>& SeedPieces,
+	int32 GroupMode,
+	bool bStencilSeeds,
+	bool bPayload,
+	int32 FloodPassCount,
+	int32 RefinementPassCount,
+	float MaxDistance,
+	float ViewSplit,
+	FRDGTextureRef PrimaryRenderTargetTexture,
+	FRDGTextureRef SecondaryRenderTargetTexture)
 {
-	FJumpFloodFloodPassPS::FParameters* Parameters = GraphBuilder.AllocParameters<FJumpFloodFloodPassPS::FParameters>();
+	RDG_EVENT_SCOPE(GraphBuilder, "JumpFlood - Groups");
+
+	const FIntPoint Extent = IntermediateViewport.Size();
+	const FVector2f TextureSize(Extent);
+	const FIntVector GroupCount = FComputeShaderUtils::GetGroupCount(Extent, JumpFloodTileSize);
+	const FSceneTextureShaderParameters SceneTextures = GetSceneTextureParameters(GraphBuilder, ViewInfo);
+
+	const FRDGTextureDesc GroupSeedDesc = FRDGTextureDesc::Create2D(Extent, PF_R32G32B32A32_UINT, FClearValueBinding::Black, TexCreate_ShaderResource | TexCreate_UAV);
+	FRDGTextureRef GroupSeedTextures[] = {
+		GraphBuilder.CreateTexture(GroupSeedDesc, TEXT("JumpFloodGroupSeeds_0")),
+		GraphBuilder.CreateTexture(GroupSeedDesc, TEXT("JumpFloodGroupSeeds_1")),
+	};
+
+	AddTextureMemoryStats(
+		GetTextureMemoryKB(Extent, PF_R32G32B32A32_UINT) * 2 + (PrimaryRenderTargetTexture ? 0 : GetTextureMemoryKB(Extent, PF_A32B32G32R32F) * 2),
+		0);
+
+	int32 ReadIndex = 0;
+	int32 WriteIndex = 1;
+
+	//  Seed sources go in first, for the stencil's seeds to be written over
+	AddClearUAVPass(GraphBuilder, GraphBuilder.CreateUAV(GroupSeedTextures[WriteIndex]), 0u);
+	if (SeedPieces.Num() > 0)
+	{
+		AddSeedSourcePass_RenderThread(GraphBuilder, GlobalShaderMap, SeedPieces, GroupSeedTextures[WriteIndex], nullptr, nullptr, true, GroupMode);
+	}
+
+	if (bStencilSeeds)
+	{
+		Swap(ReadIndex, WriteIndex);
+
+		FJumpFloodSeedGroupsCS::FPermutationDomain PermutationVector;
+		PermutationVector.Set<FJumpFloodSeedCrossDim>(CVarJumpFloodSeedEdgeDetection.GetValueOnRenderThread() == 1);
+
+		FJumpFloodSeedGroupsCS::FParameters* Parameters = GraphBuilder.AllocParameters<FJumpFloodSeedGroupsCS::FParameters>();
+		Parameters->View = ViewInfo.ViewUniformBuffer;
+		Parameters->SceneTextures = SceneTextures;
+		Parameters->ViewportMin = FVector2f(RenderViewport.Min);
+		Parameters->ViewportSize = FVector2f(RenderViewport.Size());
+		Parameters->TextureSize = TextureSize;
+		Parameters->TextureSizeInverse = FVector2f(1.0f, 1.0f) / TextureSize;
+		Parameters->GroupMode = GroupMode;
+		Parameters->GroupSeedTexture = GroupSeedTextures[ReadIndex];
+		Parameters->GroupSeedOutputTexture = GraphBuilder.CreateUAV(GroupSeedTextures[WriteIndex]);
+
+		TShaderMapRef<FJumpFloodSeedGroupsCS> ComputeShader(GlobalShaderMap, PermutationVector);
+		FComputeShaderUtils::AddPass(GraphBuilder, RDG_EVENT_NAME("JumpFlood - Seed Groups"), ComputeShader, Parameters, GroupCount);
+	}
+
+	TShaderMapRef<FJumpFloodFloodGroupsCS> FloodShader(GlobalShaderMap);
+	const auto AddFloodGroupsPass = [&](int32 FloodExponent)
+	{
+		Swap(ReadIndex, WriteIndex);
+
+		FJumpFloodFloodGroupsCS::FParameters* Parameters = GraphBuilder.AllocParameters<FJumpFloodFloodGroupsCS::FParameters>();
+		Parameters->TextureSize = TextureSize;
+		Parameters->FloodStepSize = ((float) (1 << FloodExponent));
+		Parameters->ViewSplit = ViewSplit;
+		Parameters->GroupSeedTexture = GroupSeedTextures[ReadIndex];
+		Parameters->GroupSeedOutputTexture = GraphBuilder.CreateUAV(GroupSeedTextures[WriteIndex]);
+
+		FComputeShaderUtils::AddPass(GraphBuilder, RDG_EVENT_NAME("JumpFlood - Flood Groups (Step %d)", 1 << FloodExponent), FloodShader, Parameters, GroupCount);
+	};
+
+	//  The same 1+JFA schedule, and refinement steps, as an ungrouped flood
+	AddFloodGroupsPass(0);
+
+	for (int32 FloodExponent = FloodPassCount; FloodExponent > -1; FloodExponent -= 1)
+	{
+		AddFloodGroupsPass(FloodExponent);
+	}
+
+	for (int32 FloodExponent = RefinementPassCount - 1; FloodExponent > -1; FloodExponent -= 1)
+	{
+		AddFloodGroupsPass(FloodExponent);
+	}
+
+	FRDGTextureRef GroupSeedTexture = GroupSeedTextures[WriteIndex];
+
+	//  Without render targets the field is published straight to post processing, resolved at intermediate resolution
+	if (!PrimaryRenderTargetTexture)
+	{
+		FRDGTextureDesc FieldDesc = FRDGTextureDesc::Create2D(Extent, PF_A32B32G32R32F, FClearValueBinding::Transparent, TexCreate_ShaderResource | TexCreate_UAV);
+
+		FJumpFloodResolveOutput ResolveOutput;
+		ResolveOutput.PrimaryTexture = GraphBuilder.CreateTexture(FieldDesc, TEXT("JumpFloodField_0"));
+		ResolveOutput.SecondaryTexture = GraphBuilder.CreateTexture(FieldDesc, TEXT("JumpFloodField_1"));
+		ResolveOutput.ViewInfo = &ViewInfo;
+		ResolveOutput.Viewport = RenderViewport;
+		ResolveOutput.MaxDistance = MaxDistance;
+		ResolveOutput.bPayload = bPayload;
+
+		FJumpFloodResolveGroupsCS::FParameters* Parameters = GraphBuilder.AllocParameters<FJumpFloodResolveGroupsCS::FParameters>();
+		Parameters->View = ViewInfo.ViewUniformBuffer;
+		Parameters->SceneTextures = SceneTextures;
+		Parameters->ViewportMin = FVector2f(RenderViewport.Min);
+		Parameters->ViewportSize = FVector2f(RenderViewport.Size());
+		Parameters->TextureSize = TextureSize;
+		Parameters->TextureSizeInverse = FVector2f(1.0f, 1.0f) / TextureSize;
+		Parameters->MaxDistance = MaxDistance;
+		Parameters->GroupMode = GroupMode;
+		Parameters->GroupSeedTexture = GroupSeedTexture;
+		Parameters->PrimaryOutputTexture = GraphBuilder.CreateUAV(ResolveOutput.PrimaryTexture);
+		Parameters->SecondaryOutputTexture = GraphBuilder.CreateUAV(ResolveOutput.SecondaryTexture);
+
+		FJumpFloodResolveGroupsCS::FPermutationDomain PermutationVector;
+		PermutationVector.Set<FJumpFloodPayloadDim>(bPayload);
+
+		TShaderMapRef<FJumpFloodResolveGroupsCS> ComputeShader(GlobalShaderMap, PermutationVector);
+		FComputeShaderUtils::AddPass(GraphBuilder, RDG_EVENT_NAME("JumpFlood - Resolve Groups"), ComputeShader, Parameters, GroupCount);
+
+		PublishField_RenderThread(GraphBuilder, ViewInfo, ResolveOutput, ViewSplit);
+		return;
+	}
+
+	FJumpFloodCopyGroupsPS::FParameters* Parameters = GraphBuilder.AllocParameters<FJumpFloodCopyGroupsPS::FParameters>();
 	Parameters->View = ViewInfo.ViewUniformBuffer;
-	Parameters->SceneTextures = CreateSceneTextureShaderParameters(GraphBuilder, ViewInfo.GetSceneTexturesChecked(), ViewInfo.GetFeatureLevel(), ESceneTextureSetupMode::All);
-	Parameters->TextureSize = PrimaryReadTexture->Desc.Extent;
+	Parameters->SceneTextures = SceneTextures;
+	Parameters->ViewportMin = RenderViewport.Min;
+	Parameters->CopyDestinationResolution = RenderViewport.Size();
+	Parameters->MaxDistance = MaxDistance;
+	Parameters->TextureSize = TextureSize;
+	Parameters->TextureSizeInverse = FVector2f(1.0f, 1.0f) / TextureSize;
+	Parameters->GroupMode = GroupMode;
+	Parameters->GroupSeedTexture = GroupSeedTexture;
+	Parameters->RenderTargets[0] = FRenderTargetBinding(PrimaryRenderTargetTexture, ERenderTargetLoadAction::ELoad);
+	Parameters->RenderTargets[1] = FRenderTargetBinding(SecondaryRenderTargetTexture, ERenderTargetLoadAction::ELoad);
+
+	FJumpFloodCopyGroupsPS::FPermutationDomain PermutationVector;
+	PermutationVector.Set<FJumpFloodPayloadDim>(bPayload);
+	PermutationVector.Set<FJumpFloodNativeScaleDim>(RenderViewport.Size() == Extent);
+
+	TShaderMapRef<FJumpFloodCopyGroupsPS> PixelShader(GlobalShaderMap, PermutationVector);
+	FPixelShaderUtils::AddFullscreenPass(GraphBuilder, GlobalShaderMap, RDG_EVENT_NAME("JumpFlood - Resolve Groups"), PixelShader, Parameters, RenderViewport);
+}
+
+FJumpFloodTileList FJumpFloodPassSceneViewExtension::AddTileClassificationPasses_RenderThread(
+	FRDGBuilder& GraphBuilder,
+	const FGlobalShaderMap* GlobalShaderMap,
+	const FIntRect& IntermediateViewport,
+	const FRDGTextureRef& SeedTexture,
+	bool bPackedSeeds,
+	int32 TileRadius)
+{
+	RDG_EVENT_SCOPE(GraphBuilder, "JumpFlood - Tile Classification");
+
+	const FIntPoint TileCount = FIntPoint::DivideAndRoundUp(IntermediateViewport.Size(), JumpFloodTileSize);
+
+	FRDGBufferUAVRef AnyTileUAV = nullptr;
+	const FJumpFloodTileMask SeedTiles = CreateTileMask(GraphBuilder, TileCount, TEXT("JumpFloodSeedTiles"), AnyTileUAV);
+
+	//  Tiles holding at least one seed
+	{
+		FJumpFloodClassifyTilesCS::FParameters* Parameters = GraphBuilder.AllocParameters<FJumpFloodClassifyTilesCS::FParameters>();
+		Parameters->TextureSize = SeedTexture->Desc.Extent;
+		Parameters->TileCount = FUintVector2(TileCount.X, TileCount.Y);
+		if (bPackedSeeds)
+		{
+			Parameters->SeedTexture = SeedTexture;
+		}
+		else
+		{
+			Parameters->PrimaryTexture = SeedTexture;
+		}
+		Parameters->TileMaskOutput = GraphBuilder.CreateUAV(SeedTiles.Tiles);
+		Parameters->AnyTileOutput = AnyTileUAV;
+
+		FJumpFloodClassifyTilesCS::FPermutationDomain PermutationVector;
+		PermutationVector.Set<FJumpFloodPackedSeedDim>(bPackedSeeds);
+
+		TShaderMapRef<FJumpFloodClassifyTilesCS> ComputeShader(GlobalShaderMap, PermutationVector);
+		FComputeShaderUtils::AddPass(GraphBuilder, RDG_EVENT_NAME("JumpFlood - Classify Tiles"), ComputeShader, Parameters, FIntVector(TileCount.X, TileCount.Y, 1));
+	}
+
+	return AddTileListPasses_RenderThread(GraphBuilder, GlobalShaderMap, SeedTiles, TileRadius);
+}
+
+FJumpFloodTileMask FJumpFloodPassSceneViewExtension::AddTileHashPass_RenderThread(
+	FRDGBuilder& GraphBuilder,
+	const FGlobalShaderMap* GlobalShaderMap,
+	const FViewInfo& ViewInfo,
+	const FIntRect& RenderViewport,
+	const FIntRect& IntermediateViewport,
+	FRDGTextureRef PreviousTileHash,
+	FJumpFloodHistory& History)
+{
+	const FIntPoint TileCount = FIntPoint::DivideAndRoundUp(IntermediateViewport.Size(), JumpFloodTileSize);
+
+	FRDGTextureRef TileHash = GraphBuilder.CreateTexture(FRDGTextureDesc::Create2D(TileCount, PF_R32_UINT, FClearValueBinding::None, TexCreate_ShaderResource | TexCreate_UAV), TEXT("JumpFloodTileHash"));
+
+	FRDGBufferUAVRef AnyTileUAV = nullptr;
+	const FJumpFloodTileMask DirtyTiles = CreateTileMask(GraphBuilder, TileCount, TEXT("JumpFloodDirtyTiles"), AnyTileUAV);
+
+	FJumpFloodHashTilesCS::FParameters* Parameters = GraphBuilder.AllocParameters<FJumpFloodHashTilesCS::FParameters>();
+	Parameters->View = ViewInfo.ViewUniformBuffer;
+	Parameters->SceneTextures = GetSceneTextureParameters(GraphBuilder, ViewInfo);
+	Parameters->ViewportMin = RenderViewport.Min;
+	Parameters->ViewportSize = RenderViewport.Size();
+	Parameters->TextureSize = IntermediateViewport.Size();
 	Parameters->TextureSizeInverse = FVector2f(1.0f, 1.0f) / Parameters->TextureSize;
-	Parameters->PrimaryTexture = PrimaryReadTexture;
-	Parameters->SecondaryTexture = SecondaryReadTexture;
-	Parameters->FloodStepSize = ((float) (1 << FloodExponent));
+	Parameters->PreviousTileHash = PreviousTileHash ? PreviousTileHash : GSystemTextures.GetZeroUIntDummy(GraphBuilder);
+	Parameters->TileHashOutput = GraphBuilder.CreateUAV(TileHash);
+	Parameters->TileMaskOutput = GraphBuilder.CreateUAV(DirtyTiles.Tiles);
+	Parameters->AnyTileOutput = AnyTileUAV;
 
-	Parameters->RenderTargets[0] = FRenderTargetBinding(PrimaryWriteTexture, ERenderTargetLoadAction::ELoad);
-	Parameters->RenderTargets[1] = FRenderTargetBinding(SecondaryWriteTexture, ERenderTargetLoadAction::ELoad);
+	TShaderMapRef<FJumpFloodHashTilesCS> ComputeShader(GlobalShaderMap);
+	FComputeShaderUtils::AddPass(GraphBuilder, RDG_EVENT_NAME("JumpFlood - Hash Tiles"), ComputeShader, Parameters, FIntVector(TileCount.X, TileCount.Y, 1));
 
-	TShaderMapRef<FJumpFloodFloodPassPS> PixelShader(GlobalShaderMap);
-	FPixelShaderUtils::AddFullscreenPass(GraphBuilder, GlobalShaderMap, FRDGEventName(TEXT("JumpFlood - Flood (%d)"), (1 << FloodExponent)), PixelShader, Parameters, IntermediateViewport);
+	GraphBuilder.QueueTextureExtraction(TileHash, &History.TileHash);
+
+	if (DirtyTileReadbacks.Num() == 0)
+	{
+		DirtyTileReadbacks.SetNum(JumpFloodDirtyTileReadbackCount);
+		for (FJumpFloodDirtyTileReadback& DirtyTileReadback : DirtyTileReadbacks)
+		{
+			DirtyTileReadback.Readback = MakeUnique<FRHIGPUBufferReadback>(TEXT("JumpFloodDirtyTiles"));
+		}
+	}
+
+	//  The count only feeds the stats, so it is left out rather than waited on when the GPU is too far behind
+	FJumpFloodDirtyTileReadback& DirtyTileReadback = DirtyTileReadbacks[NextDirtyTileReadback];
+	if (!DirtyTileReadback.bPending)
+	{
+		AddEnqueueCopyPass(GraphBuilder, DirtyTileReadback.Readback.Get(), DirtyTiles.AnyTile->GetParent(), sizeof(uint32));
+
+		DirtyTileReadback.FrameNumber = ViewInfo.Family->FrameNumber;
+		DirtyTileReadback.TileCount = TileCount.X * TileCount.Y;
+		DirtyTileReadback.bPending = true;
+		NextDirtyTileReadback = (NextDirtyTileReadback + 1) % DirtyTileReadbacks.Num();
+	}
+
+	return DirtyTiles;
+}
+
+FJumpFloodTileList FJumpFloodPassSceneViewExtension::AddTileListPasses_RenderThread(
+	FRDGBuilder& GraphBuilder,
+	const FGlobalShaderMap* GlobalShaderMap,
+	const FJumpFloodTileMask& TileMask,
+	int32 TileRadius)
+{
+	const FIntPoint TileCount = TileMask.Tiles->Desc.Extent;
+
+	FRDGBufferRef TileListBuffer = GraphBuilder.CreateBuffer(FRDGBufferDesc::CreateStructuredDesc(sizeof(uint32), TileCount.X * TileCount.Y), TEXT("JumpFloodTileList"));
+	FRDGBufferRef IndirectArgs = GraphBuilder.CreateBuffer(FRDGBufferDesc::CreateIndirectDesc(JumpFloodTileArgsCount), TEXT("JumpFloodTileArgs"));
+
+	FRDGBufferUAVRef IndirectArgsUAV = GraphBuilder.CreateUAV(IndirectArgs, PF_R32_UINT);
+	AddClearUAVPass(GraphBuilder, IndirectArgsUAV, 0);
+
+	//  Dilated by the radius, horizontally...
+	FRDGTextureRef DilatedTileMask = TileMask.Tiles;
+	if (TileRadius > 0)
+	{
+		DilatedTileMask = GraphBuilder.CreateTexture(TileMask.Tiles->Desc, TEXT("JumpFloodDilatedTiles"));
+
+		FJumpFloodDilateTilesCS::FParameters* Parameters = GraphBuilder.AllocParameters<FJumpFloodDilateTilesCS::FParameters>();
+		Parameters->TileCount = FUintVector2(TileCount.X, TileCount.Y);
+		Parameters->TileRadius = TileRadius;
+		Parameters->TileMask = TileMask.Tiles;
+		Parameters->TileMaskOutput = GraphBuilder.CreateUAV(DilatedTileMask);
+
+		TShaderMapRef<FJumpFloodDilateTilesCS> ComputeShader(GlobalShaderMap);
+		FComputeShaderUtils::AddPass(GraphBuilder, RDG_EVENT_NAME("JumpFlood - Dilate Tiles"), ComputeShader, Parameters, FComputeShaderUtils::GetGroupCount(TileCount, JumpFloodTileSize));
+	}
+
+	//  ...then vertically while appending to the list
+	{
+		FJumpFloodBuildTileListCS::FParameters* Parameters = GraphBuilder.AllocParameters<FJumpFloodBuildTileListCS::FParameters>();
+		Parameters->TileCount = FUintVector2(TileCount.X, TileCount.Y);
+		Parameters->TileRadius = TileRadius;
+		Parameters->TileMask = DilatedTileMask;
+		Parameters->AnyTile = TileMask.AnyTile;
+		Parameters->TileArgsOutput = IndirectArgsUAV;
+		Parameters->TileListOutput = GraphBuilder.CreateUAV(TileListBuffer);
+
+		TShaderMapRef<FJumpFloodBuildTileListCS> ComputeShader(GlobalShaderMap);
+		FComputeShaderUtils::AddPass(GraphBuilder, RDG_EVENT_NAME("JumpFlood - Build Tile List"), ComputeShader, Parameters, FComputeShaderUtils::GetGroupCount(TileCount, JumpFloodTileSize));
+	}
+
+	FJumpFloodTileList TileList;
+	TileList.Tiles = GraphBuilder.CreateSRV(TileListBuffer);
+	TileList.IndirectArgs = IndirectArgs;
+	return TileList;
+}
+
+FJumpFloodViewState& FJumpFloodPassSceneViewExtension::FindOrAddViewState_RenderThread(const FViewInfo& ViewInfo)
+{
+	const uint32 FrameNumber = ViewInfo.Family->FrameNumber;
+
+	//  Views that stopped rendering, such as a closed split-screen player or editor viewport, release their history
+	for (auto It = ViewStates.CreateIterator(); It; ++It)
+	{
+		if (FrameNumber - It.Value()->LastFrameNumber > JumpFloodViewStateTimeoutFrames)
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	//  Views without a view state get one that is started over every time, rather than all sharing the one at key 0
+	if (ViewInfo.GetViewKey() == 0)
+	{
+		TransientViewState = FJumpFloodViewState();
+		TransientViewState.LastFrameNumber = FrameNumber;
+		return TransientViewState;
+	}
+
+	TUniquePtr<FJumpFloodViewState>& ViewState = ViewStates.FindOrAdd(ViewInfo.GetViewKey());
+	if (!ViewState)
+	{
+		ViewState = MakeUnique<FJumpFloodViewState>();
+	}
+
+	ViewState->LastFrameNumber = FrameNumber;
+	return *ViewState;
+}
+
+bool FJumpFloodPassSceneViewExtension::UpdateOutputWriter_RenderThread(uint32 ViewKey, uint32 FrameNumber, const FIntRect& Viewport)
+{
+	//  The view's own region is only still its own if nothing else wrote any part of it since
+	bool bOwnWrite = false;
+	bool bOtherWrite = false;
+
+	for (auto It = OutputWriters.CreateIterator(); It; ++It)
+	{
+		//  Writers that old have outlived the history of every view they could have written over
+		if (FrameNumber - It->FrameNumber > JumpFloodViewStateTimeoutFrames)
+		{
+			It.RemoveCurrent();
+			continue;
+		}
+
+		if (!It->Viewport.Intersect(Viewport))
+		{
+			continue;
+		}
+
+		bOwnWrite |= It->ViewKey == ViewKey && It->Viewport == Viewport;
+		bOtherWrite |= It->ViewKey != ViewKey || It->Viewport != Viewport;
+
+		//  Whoever wrote the rest of an overlapping region finds out from this write instead
+		It.RemoveCurrent();
+	}
+
+	FJumpFloodOutputWriter& OutputWriter = OutputWriters.AddDefaulted_GetRef();
+	OutputWriter.Viewport = Viewport;
+	OutputWriter.ViewKey = ViewKey;
+	OutputWriter.FrameNumber = FrameNumber;
+
+	return bOwnWrite && !bOtherWrite;
+}
+
+void FJumpFloodPassSceneViewExtension::UpdateBudget_RenderThread(uint32 FrameNumber, float BudgetMs)
+{
+	//  Once per frame, however many views it floods
+	if (BudgetFrames.Num() > 0 && BudgetFrames.Last().FrameNumber == FrameNumber)
+	{
+		return;
+	}
+
+	//  Frames are read in order, each only once the GPU has written all of its timestamps
+	while (BudgetFrames.Num() > 0)
+	{
+		uint64 FrameCostMicroseconds = 0;
+		bool bFrameComplete = true;
+
+		for (const FJumpFloodBudgetTimer& Timer : BudgetFrames[0].Timers)
+		{
+			uint64 BeginMicroseconds = 0;
+			uint64 EndMicroseconds = 0;
+			if (!RHIGetRenderQueryResult(Timer.BeginQuery.GetQuery(), BeginMicroseconds, false)
+				|| !RHIGetRenderQueryResult(Timer.EndQuery.GetQuery(), EndMicroseconds, false))
+			{
+				bFrameComplete = false;
+				break;
+			}
+
+			FrameCostMicroseconds += EndMicroseconds > BeginMicroseconds ? EndMicroseconds - BeginMicroseconds : 0;
+		}
+
+		if (!bFrameComplete)
+		{
+			break;
+		}
+
+		if (BudgetFrames[0].Timers.Num() > 0)
+		{
+			UpdateBudgetDecisions(BudgetState, (float) FrameCostMicroseconds / 1000.0f, BudgetMs);
+		}
+		BudgetFrames.RemoveAt(0);
+	}
+
+	//  Timings that never arrive, say after the device was lost, mustn't hold back every later one
+	if (BudgetFrames.Num() >= JumpFloodBudgetMaxPendingFrames)
+	{
+		BudgetFrames.RemoveAt(0);
+	}
+
+	BudgetFrames.AddDefaulted_GetRef().FrameNumber = FrameNumber;
+
+	FScopeLock Lock(&PublishedBudgetStateCriticalSection);
+	PublishedBudgetState = BudgetState;
+}
+
+void FJumpFloodPassSceneViewExtension::ResetBudget_RenderThread()
+{
+	//  Budgeting starts again from full quality
+	BudgetFrames.Reset();
+	BudgetState = FJumpFloodBudgetState();
+	BudgetState.RefinementPassCount = FMath::Max(CVarJumpFloodRefinementPasses.GetValueOnRenderThread(), 0);
+
+	FScopeLock Lock(&PublishedBudgetStateCriticalSection);
+	PublishedBudgetState = BudgetState;
+}
+
+FRHIRenderQuery* FJumpFloodPassSceneViewExtension::AddBudgetTimerBeginPass_RenderThread(FRDGBuilder& GraphBuilder)
+{
+	if (!BudgetQueryPool.IsValid())
+	{
+		BudgetQueryPool = RHICreateRenderQueryPool(RQT_AbsoluteTime);
+	}
+
+	FJumpFloodBudgetTimer& Timer = BudgetFrames.Last().Timers.AddDefaulted_GetRef();
+	Timer.BeginQuery = BudgetQueryPool->AllocateQuery();
+	Timer.EndQuery = BudgetQueryPool->AllocateQuery();
+
+	AddTimestampPass(GraphBuilder, Timer.BeginQuery.GetQuery());
+	return Timer.EndQuery.GetQuery();
+}
+
+FJumpFloodBudgetState FJumpFloodPassSceneViewExtension::GetBudgetState() const
+{
+	FScopeLock Lock(&PublishedBudgetStateCriticalSection);
+	return PublishedBudgetState;
+}
+
+void FJumpFloodPassSceneViewExtension::ProcessDirtyTileReadbacks_RenderThread()
+{
+	uint32 LatestFrameNumber = 0;
+	uint32 DirtyTileCount = 0;
+	uint32 TileCount = 0;
+	bool bAnyReady = false;
+
+	//  Every view flooded on the latest finished frame adds up, and anything older is only released
+	for (FJumpFloodDirtyTileReadback& DirtyTileReadback : DirtyTileReadbacks)
+	{
+		if (!DirtyTileReadback.bPending || !DirtyTileReadback.Readback->IsReady())
+		{
+			continue;
+		}
+
+		const uint32 ReadbackDirtyTileCount = *static_cast<const uint32*>(DirtyTileReadback.Readback->Lock(sizeof(uint32)));
+		DirtyTileReadback.Readback->Unlock();
+		DirtyTileReadback.bPending = false;
+
+		if (!bAnyReady || (int32) (DirtyTileReadback.FrameNumber - LatestFrameNumber) > 0)
+		{
+			LatestFrameNumber = DirtyTileReadback.FrameNumber;
+			DirtyTileCount = 0;
+			TileCount = 0;
+		}
+
+		if (DirtyTileReadback.FrameNumber == LatestFrameNumber)
+		{
+			DirtyTileCount += ReadbackDirtyTileCount;
+			TileCount += DirtyTileReadback.TileCount;
+		}
+
+		bAnyReady = true;
+	}
+
+	if (bAnyReady)
+	{
+		SET_DWORD_STAT(STAT_JumpFloodTemporalDirtyTiles, DirtyTileCount);
+		SET_DWORD_STAT(STAT_JumpFloodTemporalTiles, TileCount);
+		CSV_CUSTOM_STAT(JumpFlood, TemporalDirtyTiles, (int32) DirtyTileCount, ECsvCustomStatOp::Set);
+	}
+}
+
+void FJumpFloodPassSceneViewExtension::ProcessFieldQueryReadbacks_RenderThread()
+{
+	//  The ring is walked from the oldest readback, so the last one published is always the newest
+	for (int32 Offset = 0; Offset < FieldQueryReadbacks.Num(); ++Offset)
+	{
+		FJumpFloodFieldQueryReadback& FieldQueryReadback = FieldQueryReadbacks[(NextFieldQueryReadback + Offset) % FieldQueryReadbacks.Num()];
+		if (!FieldQueryReadback.bPending)
+		{
+			continue;
+		}
+
+		if (!FieldQueryReadback.Readback->IsReady())
+		{
+			break;
+		}
+
+		const int32 QueryCount = FieldQueryReadback.QueryIds.Num();
+		const FVector4f* Texels = static_cast<const FVector4f*>(FieldQueryReadback.Readback->Lock(QueryCount * 2 * sizeof(FVector4f)));
+
+		TMap<int32, FJumpFloodFieldQueryResult> Results;
+		Results.Reserve(QueryCount);
+
+		for (int32 QueryIndex = 0; QueryIndex < QueryCount; ++QueryIndex)
+		{
+			const FVector4f& Primary = Texels[QueryIndex * 2];
+			const FVector4f& Secondary = Texels[QueryIndex * 2 + 1];
+
+			FJumpFloodFieldQueryResult& Result = Results.Add(FieldQueryReadback.QueryIds[QueryIndex]);
+			Result.Distance = Primary.Z;
+			Result.SeedUV = FVector2f(Primary.X, Primary.Y);
+			Result.StencilId = FMath::RoundToInt(Secondary.X);
+			Result.Depth = Secondary.Y;
+			Result.bHasSeed = Primary.W != 0.0f;
+			Result.FrameNumber = FieldQueryReadback.FrameNumber;
+		}
+
+		FieldQueryReadback.Readback->Unlock();
+		FieldQueryReadback.bPending = false;
+
+		FScopeLock Lock(&FieldQueryResultsCriticalSection);
+		FieldQueryResults = MoveTemp(Results);
+	}
+}
+
+void FJumpFloodPassSceneViewExtension::AddFieldQueryPass_RenderThread(
+	FRDGBuilder& GraphBuilder,
+	const FGlobalShaderMap* GlobalShaderMap,
+	const FViewInfo& ViewInfo,
+	FRDGTextureRef PrimaryTexture,
+	FRDGTextureRef SecondaryTexture,
+	const FIntRect& Viewport)
+{
+	const uint32 FrameNumber = ViewInfo.Family->FrameNumber;
+
+	//  Once per frame, from the chosen view or else whichever is flooded first
+	if (FieldQueryFrameNumber == FrameNumber || (FieldQueryViewKey_RenderThread != 0 && ViewInfo.GetViewKey() != FieldQueryViewKey_RenderThread))
+	{
+		return;
+	}
+	FieldQueryFrameNumber = FrameNumber;
+
+	if (FieldQueryIds_RenderThread.Num() == 0 || Viewport.IsEmpty() || !PrimaryTexture || !SecondaryTexture)
+	{
+		return;
+	}
+
+	if (FieldQueryReadbacks.Num() == 0)
+	{
+		FieldQueryReadbacks.SetNum(JumpFloodFieldQueryReadbackCount);
+		for (FJumpFloodFieldQueryReadback& FieldQueryReadback : FieldQueryReadbacks)
+		{
+			FieldQueryReadback.Readback = MakeUnique<FRHIGPUBufferReadback>(TEXT("JumpFloodFieldQueries"));
+		}
+	}
+
+	//  When the GPU is further behind than the ring covers, this frame goes unanswered rather than anything waiting on it
+	FJumpFloodFieldQueryReadback& FieldQueryReadback = FieldQueryReadbacks[NextFieldQueryReadback];
+	if (FieldQueryReadback.bPending)
+	{
+		return;
+	}
+
+	const int32 QueryCount = FieldQueryIds_RenderThread.Num();
+	const uint32 OutputBytes = QueryCount * 2 * sizeof(FVector4f);
+
+	FRDGBufferRef OutputBuffer = GraphBuilder.CreateBuffer(FRDGBufferDesc::CreateStructuredDesc(sizeof(FVector4f), QueryCount * 2), TEXT("JumpFloodFieldQueryOutput"));
+
+	FJumpFloodFieldQueryCS::FParameters* Parameters = GraphBuilder.AllocParameters<FJumpFloodFieldQueryCS::FParameters>();
+	Parameters->ViewportMin = FVector2f(Viewport.Min);
+	Parameters->ViewportSize = FVector2f(Viewport.Size());
+	Parameters->FieldQueryCount = QueryCount;
+	Parameters->PrimaryTexture = PrimaryTexture;
+	Parameters->SecondaryTexture = SecondaryTexture;
+	Parameters->FieldQueryPoints = GraphBuilder.CreateSRV(CreateStructuredBuffer(GraphBuilder, TEXT("JumpFloodFieldQueryPoints"), FieldQueryPoints_RenderThread));
+	Parameters->FieldQueryOutput = GraphBuilder.CreateUAV(OutputBuffer);
+
+	TShaderMapRef<FJumpFloodFieldQueryCS> ComputeShader(GlobalShaderMap);
+	FComputeShaderUtils::AddPass(
+		GraphBuilder,
+		RDG_EVENT_NAME("JumpFlood - Field Queries (%d)", QueryCount),
+		ComputeShader,
+		Parameters,
+		FIntVector(FMath::DivideAndRoundUp(QueryCount, JumpFloodTileSize * JumpFloodTileSize), 1, 1));
+
+	AddEnqueueCopyPass(GraphBuilder, FieldQueryReadback.Readback.Get(), OutputBuffer, OutputBytes);
+
+	FieldQueryReadback.QueryIds = FieldQueryIds_RenderThread;
+	FieldQueryReadback.FrameNumber = FrameNumber;
+	FieldQueryReadback.bPending = true;
+	NextFieldQueryReadback = (NextFieldQueryReadback + 1) % FieldQueryReadbacks.Num();
+}
+
+bool FJumpFloodPassSceneViewExtension::ArePooledRenderTargetsStale_RenderThread() const
+{
+	//  Resizing a target recreates its resource, which the pooled wrappers have to follow
+	return !PooledPrimaryRenderTarget.IsValid()
+		|| !PooledSecondaryRenderTarget.IsValid()
+		|| PooledPrimaryRenderTarget->GetRHI() != PrimaryRenderTarget->GetRenderTargetResource()->GetRenderTargetTexture()
+		|| PooledSecondaryRenderTarget->GetRHI() != SecondaryRenderTarget->GetRenderTargetResource()->GetRenderTargetTexture();
 }
 
 void FJumpFloodPassSceneViewExtension::CreatePooledRenderTargets_RenderThread()
@@ -3,7 +3,11 @@
 #include "JumpFloodPassSettings.h"
 #include "JumpFloodPassSceneViewExtension.h"
 
+#include "Components/SplineComponent.h"
 #include "Kismet/KismetRenderingLibrary.h"
+#include "Materials/Material.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogJumpFloodPass, Log, All);
 
 bool UJumpFloodPassSubsystem::ShouldCreateSubsystem(UObject* Outer) const
 {
@@ -26,13 +30,29 @@ void UJumpFloodPassSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 
 	UTextureRenderTarget2D* PrimaryRenderTarget = UJumpFloodPassSettings::GetPrimaryRenderTarget().LoadSynchronous();
 	UTextureRenderTarget2D* SecondaryRenderTarget = UJumpFloodPassSettings::GetSecondaryRenderTarget().LoadSynchronous();
-	SceneViewExtension = FSceneViewExtensions::NewExtension<FJumpFloodPassSceneViewExtension>(PrimaryRenderTarget, SecondaryRenderTarget);
+	UMaterialInterface* PostProcessMaterial = UJumpFloodPassSettings::GetPostProcessMaterial().LoadSynchronous();
+	UMaterialParameterCollection* ViewportParameterCollection = UJumpFloodPassSettings::GetViewportParameterCollection().LoadSynchronous();
+
+	//  The field is only ever handed to this material, after tonemapping, whatever location it was authored for
+	const UMaterial* BaseMaterial = PostProcessMaterial ? PostProcessMaterial->GetMaterial() : nullptr;
+	if (BaseMaterial && BaseMaterial->BlendableLocation != BL_AfterTonemapping)
+	{
+		UE_LOG(LogJumpFloodPass, Warning, TEXT("%s is run after tonemapping with the jump flood field, ignoring its blendable location"), *PostProcessMaterial->GetPathName());
+	}
+
+	SceneViewExtension = FSceneViewExtensions::NewExtension<FJumpFloodPassSceneViewExtension>(PrimaryRenderTarget, SecondaryRenderTarget, PostProcessMaterial, ViewportParameterCollection);
 }
 
 void UJumpFloodPassSubsystem::Deinitialize()
 {
 	Super::Deinitialize();
 
+	if (SceneViewExtension.IsValid())
+	{
+		SceneViewExtension->ClearSeedSources();
+		SceneViewExtension->ClearFieldQueries();
+	}
+
 	UTextureRenderTarget2D* PrimaryRenderTarget = UJumpFloodPassSettings::GetPrimaryRenderTarget().LoadSynchronous();
 	if (PrimaryRenderTarget)
 	{
@@ -45,3 +65,150 @@ void UJumpFloodPassSubsystem::Deinitialize()
 		UKismetRenderingLibrary::ClearRenderTarget2D(this, SecondaryRenderTarget, FLinearColor::Transparent);
 	}
 }
+
+FJumpFloodSeedHandle UJumpFloodPassSubsystem::AddSeed(FJumpFloodSeedSource&& SeedSource)
+{
+	FJumpFloodSeedHandle Handle;
+	if (SceneViewExtension.IsValid())
+	{
+		Handle.Id = SceneViewExtension->AddSeedSource(MoveTemp(SeedSource));
+	}
+
+	return Handle;
+}
+
+FJumpFloodSeedHandle UJumpFloodPassSubsystem::AddPointSeed(const FVector& Location, int32 StencilId, float Radius)
+{
+	FJumpFloodSeedSource SeedSource;
+	SeedSource.Shape = EJumpFloodSeedShape::Point;
+	SeedSource.Points.Add(Location);
+	SeedSource.Radius = Radius;
+	SeedSource.StencilId = FMath::Clamp(StencilId, 1, 255);
+
+	return AddSeed(MoveTemp(SeedSource));
+}
+
+FJumpFloodSeedHandle UJumpFloodPassSubsystem::AddSegmentSeed(const FVector& Start, const FVector& End, int32 StencilId, float Radius)
+{
+	return AddPolylineSeed({ Start, End }, StencilId, Radius);
+}
+
+FJumpFloodSeedHandle UJumpFloodPassSubsystem::AddPolylineSeed(const TArray<FVector>& Points, int32 StencilId, float Radius)
+{
+	FJumpFloodSeedSource SeedSource;
+	SeedSource.Shape = EJumpFloodSeedShape::Polyline;
+	SeedSource.Points.Append(Points);
+	SeedSource.Radius = Radius;
+	SeedSource.StencilId = FMath::Clamp(StencilId, 1, 255);
+
+	return AddSeed(MoveTemp(SeedSource));
+}
+
+FJumpFloodSeedHandle UJumpFloodPassSubsystem::AddSplineSeed(const USplineComponent* Spline, int32 StencilId, float Radius, float SampleSpacing)
+{
+	if (!IsValid(Spline))
+	{
+		return FJumpFloodSeedHandle();
+	}
+
+	const float SplineLength = Spline->GetSplineLength();
+	const int32 SegmentCount = FMath::Max(FMath::CeilToInt(SplineLength / FMath::Max(SampleSpacing, 1.0f)), 1);
+
+	TArray<FVector> Points;
+	Points.Reserve(SegmentCount + 1);
+	for (int32 Index = 0; Index <= SegmentCount; ++Index)
+	{
+		Points.Add(Spline->GetLocationAtDistanceAlongSpline(SplineLength * Index / SegmentCount, ESplineCoordinateSpace::World));
+	}
+
+	return AddPolylineSeed(Points, StencilId, Radius);
+}
+
+FJumpFloodSeedHandle UJumpFloodPassSubsystem::AddScreenRectSeed(const FVector2D& Min, const FVector2D& Max, int32 StencilId)
+{
+	FJumpFloodSeedSource SeedSource;
+	SeedSource.Shape = EJumpFloodSeedShape::ScreenRect;
+	SeedSource.Points.Add(FVector(Min, 0.0));
+	SeedSource.Points.Add(FVector(Max, 0.0));
+	SeedSource.StencilId = FMath::Clamp(StencilId, 1, 255);
+
+	return AddSeed(MoveTemp(SeedSource));
+}
+
+bool UJumpFloodPassSubsystem::UpdateSeedPoints(FJumpFloodSeedHandle Handle, const TArray<FVector>& Points)
+{
+	return Handle.IsValid() && SceneViewExtension.IsValid() && SceneViewExtension->UpdateSeedSourcePoints(Handle.Id, Points);
+}
+
+void UJumpFloodPassSubsystem::RemoveSeed(FJumpFloodSeedHandle Handle)
+{
+	if (Handle.IsValid() && SceneViewExtension.IsValid())
+	{
+		SceneViewExtension->RemoveSeedSource(Handle.Id);
+	}
+}
+
+void UJumpFloodPassSubsystem::ClearSeeds()
+{
+	if (SceneViewExtension.IsValid())
+	{
+		SceneViewExtension->ClearSeedSources();
+	}
+}
+
+FJumpFloodFieldQueryHandle UJumpFloodPassSubsystem::AddFieldQuery(const FVector2D& ViewUV)
+{
+	FJumpFloodFieldQueryHandle Handle;
+	if (SceneViewExtension.IsValid())
+	{
+		Handle.Id = SceneViewExtension->AddFieldQuery(ViewUV);
+	}
+
+	return Handle;
+}
+
+bool UJumpFloodPassSubsystem::UpdateFieldQuery(FJumpFloodFieldQueryHandle Handle, const FVector2D& ViewUV)
+{
+	return Handle.IsValid() && SceneViewExtension.IsValid() && SceneViewExtension->UpdateFieldQuery(Handle.Id, ViewUV);
+}
+
+void UJumpFloodPassSubsystem::RemoveFieldQuery(FJumpFloodFieldQueryHandle Handle)
+{
+	if (Handle.IsValid() && SceneViewExtension.IsValid())
+	{
+		SceneViewExtension->RemoveFieldQuery(Handle.Id);
+	}
+}
+
+void UJumpFloodPassSubsystem::ClearFieldQueries()
+{
+	if (SceneViewExtension.IsValid())
+	{
+		SceneViewExtension->ClearFieldQueries();
+	}
+}
+
+bool UJumpFloodPassSubsystem::GetFieldQueryResult(FJumpFloodFieldQueryHandle Handle, float& Distance, FVector2D& SeedUV, int32& StencilId, float& Depth, int32& FrameNumber) const
+{
+	FJumpFloodFieldQueryResult Result;
+	if (Handle.IsValid() && SceneViewExtension.IsValid())
+	{
+		SceneViewExtension->GetFieldQueryResult(Handle.Id, Result);
+	}
+
+	Distance = Result.Distance;
+	SeedUV = FVector2D(Result.SeedUV);
+	StencilId = Result.StencilId;
+	Depth = Result.Depth;
+	FrameNumber = (int32) Result.FrameNumber;
+	return Result.bHasSeed;
+}
+
+void UJumpFloodPassSubsystem::GetBudgetState(float& CostMs, float& RenderScaleFraction, int32& FloodPassReduction, int32& RefinementPassCount) const
+{
+	const FJumpFloodBudgetState BudgetState = SceneViewExtension.IsValid() ? SceneViewExtension->GetBudgetState() : FJumpFloodBudgetState();
+	CostMs = BudgetState.SmoothedCostMs;
+	RenderScaleFraction = BudgetState.RenderScaleFraction;
+	FloodPassReduction = BudgetState.FloodPassReduction;
+	RefinementPassCount = BudgetState.RefinementPassCount;
+}
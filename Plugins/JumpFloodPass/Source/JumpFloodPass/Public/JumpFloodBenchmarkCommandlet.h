@@ -0,0 +1,33 @@
+// Copyright James Maiden. All Rights Reserved.
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "JumpFloodBenchmarkCommandlet.generated.h"
+
+/**
+ * Measures error and cost of the CPU flood on synthetic masks for each flood schedule against an exact reference, and writes
+ * the results as CSV. Needs no RHI, so it runs with -nullrhi on a build machine. Returns non-zero when the exact transform is
+ * not exact, when 1+JFA's error rate exceeds plain JFA's on the same mask by more than ErrorRateEpsilon, or when any schedule
+ * resolves the clamp beyond MaxDistance or the payload differently from CopyPS. MaxErrorRate replaces the error rate limit
+ * with a fixed rate. Errors are measured on the resolved signed distance. Only the packed seed path is emulated; the float
+ * path's rounding is not covered. The same gates run at small resolutions as the Plugins.JumpFloodPass.CPU.Gates
+ * automation test.
+ *
+ * -run=JumpFloodBenchmark [-Resolutions=256+512+1024+8192] [-Iterations=3] [-BoundedDistance=32] [-ErrorRateEpsilon=0.001]
+ *     [-MaxErrorRate=Rate] [-Csv=Path]
+ */
+UCLASS()
+class JUMPFLOODPASS_API UJumpFloodBenchmarkCommandlet final : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+
+	UJumpFloodBenchmarkCommandlet();
+
+	//~ Begin UCommandlet Interface
+	virtual int32 Main(const FString& Params) override final;
+	//~ End UCommandlet Interface
+
+};
@@ -0,0 +1,81 @@
+// Copyright James Maiden. All Rights Reserved.
+#pragma once
+
+#include "CoreMinimal.h"
+
+enum class EJumpFloodCPUMethod : uint8
+{
+	/** Same seed, 1+JFA flood and resolve as the GPU pass */
+	JumpFlood,
+
+	/** Exact euclidean distance transform to the same seeds (Felzenszwalb and Huttenlocher) */
+	ExactEDT,
+};
+
+struct FJumpFloodCPUSettings
+{
+	EJumpFloodCPUMethod Method = EJumpFloodCPUMethod::JumpFlood;
+
+	/** Furthest distance, in texels, that the flood needs to reach. 0 floods the whole mask */
+	float MaxDistance = 0.0f;
+
+	/** 1-step passes run before the halving steps. The GPU pass runs one, making it 1+JFA */
+	int32 LeadingUnitStepCount = 1;
+
+	/** Extra passes run after the halving steps, from 2^(N-1) down to 1, making it JFA+N */
+	int32 TrailingStepCount = 0;
+
+	/** Whether Compute fills the field's Secondary. Without it, Secondary is left empty */
+	bool bResolveSecondary = true;
+};
+
+/** Resolved field in the same layout as the GPU pass writes to its Primary and Secondary render targets */
+struct FJumpFloodCPUField
+{
+	FIntPoint Size = FIntPoint::ZeroValue;
+
+	/** Seed UV, signed distance in texels (negative inside the mask), and 1 where a seed was found */
+	TArray<FVector4f> Primary;
+
+	/** Stencil and depth at the seed. Empty unless resolved */
+	TArray<FVector4f> Secondary;
+};
+
+/**
+ * CPU version of the jump flood, for distance fields baked offline. Seeds are packed one uint32 per texel in the same way as
+ * the GPU's packed intermediate, with 0 meaning no seed. Every stage runs in parallel over bands of rows.
+ */
+class JUMPFLOODPASS_API FJumpFloodCPU
+{
+
+public:
+
+	/** Seeds the texels of the mask that lie on its edge, as found by the same Sobel filter as the GPU seed pass */
+	static void Seed(const FIntPoint& Size, TConstArrayView<uint8> Stencil, TArrayView<uint32> OutSeeds);
+
+	/** Jump flood of the seeds, on the schedule in Settings. A MaxDistance above 0 starts from the smallest step that still reaches it */
+	static void Flood(const FIntPoint& Size, TArrayView<uint32> InOutSeeds, const FJumpFloodCPUSettings& Settings = FJumpFloodCPUSettings());
+
+	/** Replaces every texel with its exactly nearest seed */
+	static void FloodExact(const FIntPoint& Size, TArrayView<uint32> InOutSeeds);
+
+	/** Resolves flooded seeds into the output layout. Depth may be empty, in which case it resolves as 0, and OutSecondary may be empty to skip it */
+	static void Resolve(
+		const FIntPoint& Size,
+		TConstArrayView<uint32> Seeds,
+		TConstArrayView<uint8> Stencil,
+		TConstArrayView<float> Depth,
+		float MaxDistance,
+		TArrayView<FVector4f> OutPrimary,
+		TArrayView<FVector4f> OutSecondary);
+
+	/** Seeds, floods and resolves a whole mask */
+	static FJumpFloodCPUField Compute(const FIntPoint& Size, TConstArrayView<uint8> Stencil, const FJumpFloodCPUSettings& Settings = FJumpFloodCPUSettings());
+
+	static uint32 PackSeed(int32 X, int32 Y) { return (uint32) (X + 1) | ((uint32) (Y + 1) << 16); }
+	static FIntPoint UnpackSeed(uint32 PackedSeed) { return FIntPoint((int32) (PackedSeed & 0xFFFF) - 1, (int32) (PackedSeed >> 16) - 1); }
+
+	/** Largest side that keeps squared distances between packed seed coordinates within 32 bits */
+	static constexpr int32 MaxSize = 32768;
+
+};
@@ -1,27 +1,318 @@
 #pragma once
 
+#include "RHIGPUReadback.h"
+#include "RHIResources.h"
 #include "SceneViewExtension.h"
 
+struct FPostProcessMaterialInputs;
+struct FScreenPassTexture;
+class UMaterialInterface;
+class UMaterialParameterCollection;
 class UTextureRenderTarget2D;
 
+enum class EJumpFloodSeedShape : uint8
+{
+	/** A disc around a single world location */
+	Point,
+
+	/** Capsules along consecutive pairs of world locations */
+	Polyline,
+
+	/** A filled rectangle given by its min and max in view UV */
+	ScreenRect,
+};
+
+/** Shape seeded straight into the flood, without needing anything drawn into custom depth and stencil */
+struct FJumpFloodSeedSource
+{
+	EJumpFloodSeedShape Shape = EJumpFloodSeedShape::Point;
+
+	/** World locations, or for a screen rect its min and max in view UV, held in X and Y */
+	TArray<FVector, TInlineAllocator<2>> Points;
+
+	/** Radius in output pixels */
+	float Radius = 0.0f;
+
+	/** Stencil value the field reports for this source, in the same range as custom stencil */
+	uint8 StencilId = 1;
+};
+
+/** Part of a seed source projected into a view's intermediate texels, covering at most one region of a fixed size */
+struct FJumpFloodSeedPiece
+{
+	/** Ends of the segment the piece seeds around, or the min and max of a filled rect */
+	FVector4f Segment;
+
+	/** Texels the piece is rasterized over, as min inclusive and max exclusive */
+	FVector4f Bounds;
+
+	float Radius = 0.0f;
+
+	/** 1 / depth at either end, which unlike depth interpolates linearly across the screen. 0 for screen rects */
+	float InvDepthA = 0.0f;
+	float InvDepthB = 0.0f;
+
+	/** Stencil in the low 8 bits, with JumpFloodSeedPieceFillBounds set for rects */
+	uint32 StencilAndFlags = 0;
+};
+
+/** GPU built list of the compute tiles a bounded flood has to touch, along with indirect dispatch and draw arguments covering them */
+struct FJumpFloodTileList
+{
+	FRDGBufferSRVRef Tiles = nullptr;
+	FRDGBufferRef IndirectArgs = nullptr;
+};
+
+/** Per tile flags written by a classification pass, along with a single flag that is set when any tile is */
+struct FJumpFloodTileMask
+{
+	FRDGTextureRef Tiles = nullptr;
+	FRDGBufferSRVRef AnyTile = nullptr;
+};
+
+/** What the last resolve into the render targets was made from, so a temporal flood can tell whether it still holds */
+struct FJumpFloodHistory
+{
+	TRefCountPtr<IPooledRenderTarget> TileHash;
+	FTextureRHIRef OutputTexture;
+
+	FMatrix ViewMatrix = FMatrix::Identity;
+	FMatrix ProjectionMatrix = FMatrix::Identity;
+	FVector ViewOrigin = FVector::ZeroVector;
+
+	FIntRect OutputViewport;
+	FIntPoint IntermediateExtent = FIntPoint::ZeroValue;
+	float MaxDistance = 0.0f;
+	bool bPackedSeeds = false;
+	bool bExactFlood = false;
+	bool bPayload = true;
+	int32 FloodPassReduction = 0;
+	int32 RefinementPassCount = 0;
+
+	/** Seed sources change without the stencil changing, so any change to them re-floods the whole view */
+	uint32 SeedSourcesRevision = 0;
+};
+
+/** The view that last wrote a region of the render target assets, and the frame it did so on */
+struct FJumpFloodOutputWriter
+{
+	FIntRect Viewport;
+	uint32 ViewKey = 0;
+	uint32 FrameNumber = 0;
+};
+
+/** Transient textures the last flood step resolves into instead of its ping-pong target, and what the resolve needs to do so */
+struct FJumpFloodResolveOutput
+{
+	FRDGTextureRef PrimaryTexture = nullptr;
+	FRDGTextureRef SecondaryTexture = nullptr;
+
+	const FViewInfo* ViewInfo = nullptr;
+	FIntRect Viewport;
+	float MaxDistance = 0.0f;
+
+	/** Stencil of packed seeds written by seed sources, or null when there are none */
+	FRDGTextureRef SeedStencilTexture = nullptr;
+
+	/** Whether Secondary gets the stencil and depth at the seed, rather than zero */
+	bool bPayload = true;
+};
+
+/** A view's resolved field, handed to its post process material later in the same graph */
+struct FJumpFloodPublishedField
+{
+	const FSceneView* View = nullptr;
+	FRDGTextureRef PrimaryTexture = nullptr;
+	FRDGTextureRef SecondaryTexture = nullptr;
+	FIntRect Viewport;
+};
+
+/** What the stretched copy into the render targets reads and writes, so it can run later in the graph than the flood */
+struct FJumpFloodResolve
+{
+	const FSceneView* View = nullptr;
+
+	FRDGTextureRef PrimaryTexture = nullptr;
+	FRDGTextureRef SecondaryTexture = nullptr;
+	FRDGTextureRef PrimaryRenderTargetTexture = nullptr;
+	FRDGTextureRef SecondaryRenderTargetTexture = nullptr;
+	FRDGTextureRef SeedStencilTexture = nullptr;
+
+	/** Whether PrimaryTexture holds packed seeds, with no SecondaryTexture */
+	bool bPackedSeeds = false;
+	bool bPayload = true;
+
+	FIntRect RenderViewport;
+	FIntRect IntermediateViewport;
+	float MaxDistance = 0.0f;
+
+	/** Tiles to resolve, or every tile when empty */
+	FJumpFloodTileList TileList;
+	bool bClearOutputs = true;
+};
+
+/** What the budget controller last measured, and the quality it settled on for the floods that followed */
+struct FJumpFloodBudgetState
+{
+	/** GPU time of the most recently measured frame's floods, and its smoothed average, in ms */
+	float MeasuredCostMs = 0.0f;
+	float SmoothedCostMs = 0.0f;
+
+	/** Fraction of r.JumpFloodPass.RenderScale the floods run at */
+	float RenderScaleFraction = 1.0f;
+
+	/** Largest flood steps left out, and refinement passes kept of those r.JumpFloodPass.RefinementPasses asks for */
+	int32 FloodPassReduction = 0;
+	int32 RefinementPassCount = 0;
+
+	/** Measured frames left before the next change can be made */
+	int32 CooldownFrameCount = 0;
+};
+
+/** Timestamps written around a view's floods */
+struct FJumpFloodBudgetTimer
+{
+	FRHIPooledRenderQuery BeginQuery;
+	FRHIPooledRenderQuery EndQuery;
+};
+
+/** Timers of every view flooded in a frame, read back together once the GPU has written them */
+struct FJumpFloodBudgetFrame
+{
+	uint32 FrameNumber = 0;
+	TArray<FJumpFloodBudgetTimer, TInlineAllocator<2>> Timers;
+};
+
+/** What the field held at a queried point of the view, as of the latest frame whose readback has completed */
+struct FJumpFloodFieldQueryResult
+{
+	/** Signed distance to the nearest seed in output pixels, negative inside the mask */
+	float Distance = 0.0f;
+
+	/** Nearest seed, in view UV */
+	FVector2f SeedUV = FVector2f::ZeroVector;
+
+	/** Stencil and depth at the nearest seed, or 0 without r.JumpFloodPass.Payload */
+	int32 StencilId = 0;
+	float Depth = 0.0f;
+
+	/** Whether the flood found a seed within reach. Everything else is 0 when it didn't */
+	bool bHasSeed = false;
+
+	/** Frame the answer was flooded on */
+	uint32 FrameNumber = 0;
+};
+
+/** A frame's field queries on their way back from the GPU */
+struct FJumpFloodFieldQueryReadback
+{
+	TUniquePtr<FRHIGPUBufferReadback> Readback;
+	TArray<int32> QueryIds;
+	uint32 FrameNumber = 0;
+	bool bPending = false;
+};
+
+/** A temporal flood's count of dirty tiles on its way back from the GPU */
+struct FJumpFloodDirtyTileReadback
+{
+	TUniquePtr<FRHIGPUBufferReadback> Readback;
+	uint32 FrameNumber = 0;
+	uint32 TileCount = 0;
+	bool bPending = false;
+};
+
+/** Flood spread over several frames, with the seed textures it ping-pongs between kept from one frame to the next */
+struct FJumpFloodAmortizedFlood
+{
+	/** The completed flood's seeds are in one, the flood in progress ping-pongs between the other two */
+	TRefCountPtr<IPooledRenderTarget> SeedTextures[3];
+
+	/** Device Z where the seeds of the completed flood and of the one in progress were taken */
+	TRefCountPtr<IPooledRenderTarget> DepthTextures[2];
+
+	FMatrix ViewProjectionMatrix = FMatrix::Identity;
+	FMatrix CompletedViewProjectionMatrix = FMatrix::Identity;
+
+	FIntPoint Extent = FIntPoint::ZeroValue;
+	float MaxDistance = 0.0f;
+	int32 FrameCount = 0;
+
+	/** Steps of the cascade in progress, which the budget controller can change between any two frames of it */
+	int32 FloodPassCount = 0;
+	int32 RefinementPassCount = 0;
+
+	/** Next step of the cascade in progress, 0 when the next frame starts a new one from fresh seeds */
+	int32 NextStep = 0;
+
+	int32 LatestIndex = INDEX_NONE;
+	int32 CompletedIndex = INDEX_NONE;
+	int32 DepthIndex = 0;
+	int32 CompletedDepthIndex = 0;
+};
+
+/** Everything kept between frames for a single view, keyed by its view state */
+struct FJumpFloodViewState
+{
+	FJumpFloodHistory History;
+	FJumpFloodAmortizedFlood AmortizedFlood;
+	uint32 LastFrameNumber = 0;
+};
+
 class FJumpFloodPassSceneViewExtension final : public FSceneViewExtensionBase
 {
 
 public:
 
-	FJumpFloodPassSceneViewExtension(const FAutoRegister &AutoRegister, UTextureRenderTarget2D* PrimaryRenderTarget, UTextureRenderTarget2D* SecondaryRenderTarget)
+	FJumpFloodPassSceneViewExtension(
+		const FAutoRegister &AutoRegister,
+		UTextureRenderTarget2D* PrimaryRenderTarget,
+		UTextureRenderTarget2D* SecondaryRenderTarget,
+		UMaterialInterface* PostProcessMaterial = nullptr,
+		UMaterialParameterCollection* ViewportParameterCollection = nullptr)
 		: FSceneViewExtensionBase(AutoRegister)
 		, PrimaryRenderTarget(PrimaryRenderTarget)
 		, SecondaryRenderTarget(SecondaryRenderTarget)
+		, PostProcessMaterial(PostProcessMaterial)
+		, ViewportParameterCollection(ViewportParameterCollection)
 	{
 	}
 
 public:
 
-	void SetupViewFamily(FSceneViewFamily& InViewFamily) override {}
+	void SetupViewFamily(FSceneViewFamily& InViewFamily) override;
 	void SetupView(FSceneViewFamily& InViewFamily, FSceneView& InView) override;
-	void BeginRenderViewFamily(FSceneViewFamily& InViewFamily) override {}
+	void BeginRenderViewFamily(FSceneViewFamily& InViewFamily) override;
 	void PostRenderBasePassDeferred_RenderThread(FRDGBuilder& GraphBuilder, FSceneView& InView, const FRenderTargetBindingSlots& RenderTargets, TRDGUniformBufferRef<FSceneTextureUniformParameters> SceneTextures) override;
+	void PrePostProcessPass_RenderThread(FRDGBuilder& GraphBuilder, const FSceneView& View, const FPostProcessingInputs& Inputs) override;
+	void PostRenderViewFamily_RenderThread(FRDGBuilder& GraphBuilder, FSceneViewFamily& InViewFamily) override;
+	void SubscribeToPostProcessingPass(EPostProcessingPass Pass, FAfterPassCallbackDelegateArray& InOutPassCallbacks, bool bIsPassEnabled) override;
+
+	/** Game thread. Seed sources are handed to the render thread once per frame, when the next view family begins rendering */
+	int32 AddSeedSource(FJumpFloodSeedSource&& SeedSource);
+	bool UpdateSeedSourcePoints(int32 SeedSourceId, TConstArrayView<FVector> Points);
+	void RemoveSeedSource(int32 SeedSourceId);
+	void ClearSeedSources();
+
+	/**
+	 * Game thread. Points of the view, in UV, that the field is sampled at once a frame and read back without stalling. Answers
+	 * arrive a few frames late, from the view chosen by SetFieldQueryViewKey. Not answered while r.JumpFloodPass.Groups is set
+	 */
+	int32 AddFieldQuery(const FVector2D& ViewUV);
+	bool UpdateFieldQuery(int32 FieldQueryId, const FVector2D& ViewUV);
+	void RemoveFieldQuery(int32 FieldQueryId);
+	void ClearFieldQueries();
+
+	/**
+	 * Game thread. Key of the view that answers field queries, as given by its view state's GetViewKey. 0, the default, answers
+	 * from the first view flooded in each frame, which is a scene capture whenever one is flooded before the game view
+	 */
+	void SetFieldQueryViewKey(uint32 ViewKey);
+
+	/** Game thread. The latest answer to a query, or false if none has arrived since it was added */
+	bool GetFieldQueryResult(int32 FieldQueryId, FJumpFloodFieldQueryResult& OutResult) const;
+
+	/** Any thread. The budget controller's latest decisions, as of the start of the last budgeted frame */
+	FJumpFloodBudgetState GetBudgetState() const;
 
 protected:
 
@@ -29,8 +320,88 @@ protected:
 
 private:
 
+	/** Whether the field goes straight to the post process material rather than into the render target assets */
+	bool IsPublishingField() const;
+
+	/** Drops deferred work recorded by any other graph */
+	void ResetDeferredWork_RenderThread(const FRDGBuilder& GraphBuilder, uint32 FrameNumber);
+
+	void AddResolvePass_RenderThread(FRDGBuilder& GraphBuilder, const FGlobalShaderMap* GlobalShaderMap, const FJumpFloodResolve& Resolve);
+
+	void PublishField_RenderThread(FRDGBuilder& GraphBuilder, const FViewInfo& ViewInfo, const FJumpFloodResolveOutput& ResolveOutput, float ViewSplit);
+	FScreenPassTexture PostProcessMaterialPass_RenderThread(FRDGBuilder& GraphBuilder, const FSceneView& View, const FPostProcessMaterialInputs& InOutInputs);
+
+	/** Game thread. The render target assets' size for views needing RequiredSize, rounded up to the size bucket */
+	static FIntPoint GetBucketedRenderTargetSize(const FIntPoint& RequiredSize);
+
+	/** Game thread. Grows the render target assets to fit RequiredSize right away, and only shrinks them once it has stayed smaller */
+	void UpdateRenderTargetSize(const FIntPoint& RequiredSize);
+
+	/** Game thread. Hands materials sampling the render target assets the region of them the family's views resolve into */
+	void UpdateViewportParameters(const FSceneViewFamily& InViewFamily) const;
+
+	/** Reads back every frame of timings the GPU has finished and lets the controller act on them, then starts this frame's */
+	void UpdateBudget_RenderThread(uint32 FrameNumber, float BudgetMs);
+	void ResetBudget_RenderThread();
+
+	/** Timestamps the start of a view's floods, returning the query to timestamp their end with */
+	FRHIRenderQuery* AddBudgetTimerBeginPass_RenderThread(FRDGBuilder& GraphBuilder);
+
+	/** Publishes the dirty tile counts of the latest frame the GPU has finished, for the stats */
+	void ProcessDirtyTileReadbacks_RenderThread();
+
+	/** Publishes the answers of every readback the GPU has finished, oldest first */
+	void ProcessFieldQueryReadbacks_RenderThread();
+
+	/**
+	 * Samples the field in Viewport of PrimaryTexture and SecondaryTexture at every query point and reads it back, once a frame and
+	 * only for the view queries are answered from
+	 */
+	void AddFieldQueryPass_RenderThread(
+		FRDGBuilder& GraphBuilder,
+		const FGlobalShaderMap* GlobalShaderMap,
+		const FViewInfo& ViewInfo,
+		FRDGTextureRef PrimaryTexture,
+		FRDGTextureRef SecondaryTexture,
+		const FIntRect& Viewport);
+
+	bool ArePooledRenderTargetsStale_RenderThread() const;
 	void CreatePooledRenderTargets_RenderThread();
 
+	FJumpFloodViewState& FindOrAddViewState_RenderThread(const FViewInfo& ViewInfo);
+
+	/**
+	 * Records ViewKey as the last view to write Viewport of the render target assets, returning whether it already was. Any family
+	 * rendering into them, such as a scene capture, an editor viewport or another PIE instance, can write over a view's history
+	 */
+	bool UpdateOutputWriter_RenderThread(uint32 ViewKey, uint32 FrameNumber, const FIntRect& Viewport);
+
+	/** Projects every seed source into the pieces the seed source pass rasterizes for this view, and its stereo pair */
+	void BuildSeedPieces_RenderThread(const FViewInfo& ViewInfo, const FIntRect& RenderViewport, const FIntRect& IntermediateViewport, TArray<FJumpFloodSeedPiece>& OutPieces) const;
+
+	/** Rasterizes seed pieces into a seeded target, writing their stencil into SeedStencilTexture for packed seeds */
+	void AddSeedSourcePass_RenderThread(
+		FRDGBuilder& GraphBuilder,
+		const FGlobalShaderMap* GlobalShaderMap,
+		const TArray<FJumpFloodSeedPiece>& Pieces,
+		const FRDGTextureRef& PrimaryWriteTexture,
+		const FRDGTextureRef& SecondaryWriteTexture,
+		const FRDGTextureRef& SeedStencilTexture,
+		bool bPackedSeeds,
+		int32 GroupMode = 0);
+
+	/** Seeds the whole intermediate viewport, or only the listed tiles of an already cleared target */
+	void AddSeedPass_RenderThread(
+		FRDGBuilder& GraphBuilder,
+		const FGlobalShaderMap* GlobalShaderMap,
+		const FViewInfo& ViewInfo,
+		const FIntRect& RenderViewport,
+		const FIntRect& IntermediateViewport,
+		const FRDGTextureRef& PrimaryWriteTexture,
+		const FRDGTextureRef& SecondaryWriteTexture,
+		bool bPackedSeeds,
+		const FJumpFloodTileList* TileList = nullptr);
+
 	void AddFloodPass_RenderThread(
 		FRDGBuilder& GraphBuilder,
 		const FGlobalShaderMap* GlobalShaderMap,
@@ -40,17 +411,207 @@ private:
 		const FRDGTextureRef& PrimaryWriteTexture,
 		const FRDGTextureRef& SecondaryReadTexture,
 		const FRDGTextureRef& SecondaryWriteTexture,
+		bool bPackedSeeds,
 		int32 FloodExponent,
-		float ExponentToUVScaler);
+		float ViewSplit,
+		float ExponentToUVScaler,
+		const FJumpFloodResolveOutput* ResolveOutput = nullptr);
+
+	void AddFloodComputePass_RenderThread(
+		FRDGBuilder& GraphBuilder,
+		const FGlobalShaderMap* GlobalShaderMap,
+		const FIntRect& IntermediateViewport,
+		const FRDGTextureRef& PrimaryReadTexture,
+		const FRDGTextureRef& PrimaryWriteTexture,
+		const FRDGTextureRef& SecondaryReadTexture,
+		const FRDGTextureRef& SecondaryWriteTexture,
+		bool bPackedSeeds,
+		int32 FloodExponent,
+		float SeedSpaceScale,
+		float ViewSplit,
+		ERDGPassFlags PassFlags,
+		const FJumpFloodTileList* TileList = nullptr,
+		const FJumpFloodResolveOutput* ResolveOutput = nullptr);
+
+	/**
+	 * Floods packed seeds on a level LevelCount halvings coarser, then upsamples into OutputTexture. Only the steps
+	 * smaller than the reduction are left, for the tile pass to refine at full resolution
+	 */
+	void AddHierarchicalFloodPasses_RenderThread(
+		FRDGBuilder& GraphBuilder,
+		const FGlobalShaderMap* GlobalShaderMap,
+		const FIntRect& IntermediateViewport,
+		const FRDGTextureRef& SeedTexture,
+		const FRDGTextureRef& OutputTexture,
+		int32 LevelCount,
+		int32 FloodPassCount,
+		float ViewSplit,
+		ERDGPassFlags PassFlags);
+
+	/**
+	 * Runs this frame's share of a flood spread over FrameCount frames, starting a new one from fresh seeds once the last has
+	 * completed. Returns the last completed flood's packed seeds, reprojected to this frame
+	 */
+	FRDGTextureRef AddAmortizedFloodPasses_RenderThread(
+		FRDGBuilder& GraphBuilder,
+		const FGlobalShaderMap* GlobalShaderMap,
+		const FViewInfo& ViewInfo,
+		FJumpFloodAmortizedFlood& Amortized,
+		const FIntRect& RenderViewport,
+		const FIntRect& IntermediateViewport,
+		bool bStencilSeeds,
+		int32 FrameCount,
+		int32 FloodPassCount,
+		int32 RefinementPassCount,
+		float MaxDistance,
+		ERDGPassFlags PassFlags);
+
+	/** Replaces every packed seed in OutputTexture with the exactly nearest of those in SeedTexture, in the same view */
+	void AddExactFloodPasses_RenderThread(
+		FRDGBuilder& GraphBuilder,
+		const FGlobalShaderMap* GlobalShaderMap,
+		const FRDGTextureRef& SeedTexture,
+		const FRDGTextureRef& OutputTexture,
+		float ViewSplit,
+		ERDGPassFlags PassFlags);
+
+	/** Floods every step smaller than the compute tile size in one dispatch, resolving into ResolveOutput when given */
+	void AddFloodTilePass_RenderThread(
+		FRDGBuilder& GraphBuilder,
+		const FGlobalShaderMap* GlobalShaderMap,
+		const FIntRect& IntermediateViewport,
+		const FRDGTextureRef& PrimaryReadTexture,
+		const FRDGTextureRef& PrimaryWriteTexture,
+		const FRDGTextureRef& SecondaryReadTexture,
+		const FRDGTextureRef& SecondaryWriteTexture,
+		bool bPackedSeeds,
+		float ViewSplit,
+		ERDGPassFlags PassFlags,
+		const FJumpFloodTileList* TileList = nullptr,
+		const FJumpFloodResolveOutput* ResolveOutput = nullptr);
+
+	/**
+	 * Seeds, floods and resolves up to four groups of stencil at once, each in its own channel. Resolves into the render targets
+	 * when given, and otherwise publishes the field to post processing
+	 */
+	void AddGroupFloodPasses_RenderThread(
+		FRDGBuilder& GraphBuilder,
+		const FGlobalShaderMap* GlobalShaderMap,
+		const FViewInfo& ViewInfo,
+		const FIntRect& RenderViewport,
+		const FIntRect& IntermediateViewport,
+		const TArray<FJumpFloodSeedPiece>& SeedPieces,
+		int32 GroupMode,
+		bool bStencilSeeds,
+		bool bPayload,
+		int32 FloodPassCount,
+		int32 RefinementPassCount,
+		float MaxDistance,
+		float ViewSplit,
+		FRDGTextureRef PrimaryRenderTargetTexture,
+		FRDGTextureRef SecondaryRenderTargetTexture);
+
+	/** Lists the tiles that hold a seed or lie within TileRadius tiles of one */
+	FJumpFloodTileList AddTileClassificationPasses_RenderThread(
+		FRDGBuilder& GraphBuilder,
+		const FGlobalShaderMap* GlobalShaderMap,
+		const FIntRect& IntermediateViewport,
+		const FRDGTextureRef& SeedTexture,
+		bool bPackedSeeds,
+		int32 TileRadius);
+
+	/**
+	 * Flags the tiles whose seed inputs moved further than jitter can since PreviousTileHash was written, and extracts the summaries
+	 * into History, with unflagged tiles keeping the one they were last flooded with
+	 */
+	FJumpFloodTileMask AddTileHashPass_RenderThread(
+		FRDGBuilder& GraphBuilder,
+		const FGlobalShaderMap* GlobalShaderMap,
+		const FViewInfo& ViewInfo,
+		const FIntRect& RenderViewport,
+		const FIntRect& IntermediateViewport,
+		FRDGTextureRef PreviousTileHash,
+		FJumpFloodHistory& History);
+
+	/** Lists the flagged tiles and those within TileRadius tiles of one. A negative radius lists every tile if any is flagged */
+	FJumpFloodTileList AddTileListPasses_RenderThread(
+		FRDGBuilder& GraphBuilder,
+		const FGlobalShaderMap* GlobalShaderMap,
+		const FJumpFloodTileMask& TileMask,
+		int32 TileRadius);
 
 private:
 
 	TObjectPtr<UTextureRenderTarget2D> PrimaryRenderTarget;
 	TObjectPtr<UTextureRenderTarget2D> SecondaryRenderTarget;
+	TObjectPtr<UMaterialInterface> PostProcessMaterial;
+	TObjectPtr<UMaterialParameterCollection> ViewportParameterCollection;
 
 	TRefCountPtr<IPooledRenderTarget> PooledPrimaryRenderTarget;
 	TRefCountPtr<IPooledRenderTarget> PooledSecondaryRenderTarget;
 
-	bool bShouldRecreatePooledRenderTargets = true;
+	/** Game thread. Union of every view rect in the family being set up, at its largest screen percentage */
+	FIntPoint FamilyRenderTargetSize = FIntPoint::ZeroValue;
+
+	/** Game thread. Union of every view rect in the family being set up, at its current screen percentage */
+	FIntRect FamilyActiveViewRect;
+
+	/** Game thread. Consecutive families that have fit in a smaller size bucket than the render target assets */
+	int32 RenderTargetShrinkFrameCount = 0;
+
+	/** Render thread. Held by pointer since graph extractions write into them after the map may have changed */
+	TMap<uint32, TUniquePtr<FJumpFloodViewState>> ViewStates;
+
+	/** Render thread. Handed to views without a view state, which get nothing kept from one frame to the next */
+	FJumpFloodViewState TransientViewState;
+
+	/** Render thread. Last writer of each region of the render target assets, none of them overlapping */
+	TArray<FJumpFloodOutputWriter> OutputWriters;
+
+	/** Render thread. Fields published and resolves deferred by the graph currently being built, which are invalid in any other */
+	TArray<FJumpFloodPublishedField> PublishedFields;
+	TArray<FJumpFloodResolve> DeferredResolves;
+	const FRDGBuilder* DeferredWorkGraph = nullptr;
+	uint32 DeferredWorkFrameNumber = 0;
+
+	/** Game thread. Registered seed sources by id, and whether the render thread has yet to see the latest of them */
+	TMap<int32, FJumpFloodSeedSource> SeedSources;
+	int32 NextSeedSourceId = 0;
+	bool bSeedSourcesDirty = false;
+
+	/** Render thread. Snapshot of SeedSources, and a count of the snapshots taken so history can tell they changed */
+	TArray<FJumpFloodSeedSource> SeedSources_RenderThread;
+	uint32 SeedSourcesRevision_RenderThread = 0;
+
+	/** Game thread. Field query points by id and the view answering them, and whether the render thread has yet to see the latest */
+	TMap<int32, FVector2f> FieldQueries;
+	int32 NextFieldQueryId = 0;
+	uint32 FieldQueryViewKey = 0;
+	bool bFieldQueriesDirty = false;
+
+	/** Render thread. Snapshot of FieldQueries and FieldQueryViewKey, and the ring of readbacks answering them */
+	TArray<int32> FieldQueryIds_RenderThread;
+	TArray<FVector2f> FieldQueryPoints_RenderThread;
+	uint32 FieldQueryViewKey_RenderThread = 0;
+	TArray<FJumpFloodFieldQueryReadback> FieldQueryReadbacks;
+	int32 NextFieldQueryReadback = 0;
+	uint32 FieldQueryFrameNumber = 0;
+
+	/** Render thread. Ring of readbacks counting the tiles temporal floods found dirty */
+	TArray<FJumpFloodDirtyTileReadback> DirtyTileReadbacks;
+	int32 NextDirtyTileReadback = 0;
+
+	/** Answers from the latest completed readback, by query id */
+	mutable FCriticalSection FieldQueryResultsCriticalSection;
+	TMap<int32, FJumpFloodFieldQueryResult> FieldQueryResults;
+
+	/** Render thread. Budget controller, and the frames of timings it has yet to read back */
+	FJumpFloodBudgetState BudgetState;
+	TArray<FJumpFloodBudgetFrame> BudgetFrames;
+	FRenderQueryPoolRHIRef BudgetQueryPool;
+
+	/** Copy of BudgetState for other threads */
+	mutable FCriticalSection PublishedBudgetStateCriticalSection;
+	FJumpFloodBudgetState PublishedBudgetState;
 
 };
\ No newline at end of file
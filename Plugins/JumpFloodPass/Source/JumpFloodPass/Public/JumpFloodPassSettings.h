@@ -5,6 +5,8 @@
 #include "CoreMinimal.h"
 #include "Engine/DeveloperSettings.h"
 #include "Engine/TextureRenderTarget2D.h"
+#include "Materials/MaterialInterface.h"
+#include "Materials/MaterialParameterCollection.h"
 #include "JumpFloodPassSettings.generated.h"
 
 
@@ -21,6 +23,10 @@ public:
 	static bool IsEnabled() { return GetDefault<ThisClass>()->bEnabled; }
 	static TSoftObjectPtr<UTextureRenderTarget2D> GetPrimaryRenderTarget() { return GetDefault<ThisClass>()->PrimaryRenderTarget; }
 	static TSoftObjectPtr<UTextureRenderTarget2D> GetSecondaryRenderTarget() { return GetDefault<ThisClass>()->SecondaryRenderTarget; }
+	static float GetMaxFloodDistance() { return GetDefault<ThisClass>()->MaxFloodDistance; }
+	static float GetGPUBudget() { return GetDefault<ThisClass>()->GPUBudget; }
+	static TSoftObjectPtr<UMaterialInterface> GetPostProcessMaterial() { return GetDefault<ThisClass>()->PostProcessMaterial; }
+	static TSoftObjectPtr<UMaterialParameterCollection> GetViewportParameterCollection() { return GetDefault<ThisClass>()->ViewportParameterCollection; }
 
 	//~ Begin UDeveloperSettings Interface
 	virtual FName GetContainerName() const override final { return FName("Project"); }
@@ -39,4 +45,28 @@ private:
 	UPROPERTY(Config, EditAnywhere)
 	TSoftObjectPtr<UTextureRenderTarget2D> SecondaryRenderTarget;
 
+	/** Furthest distance, in output pixels, that the flood needs to reach. Pixels outside the stencil with no seed within it resolve as having no seed, and those inside it have their distance held at -MaxFloodDistance. 0 floods the whole view. Overridden by r.JumpFloodPass.MaxDistance */
+	UPROPERTY(Config, EditAnywhere, meta = (ClampMin = "0", UIMin = "0"))
+	float MaxFloodDistance = 0.0f;
+
+	/** GPU time, in ms, each frame's floods should fit in by lowering their quality. 0 leaves the quality as set. Overridden by r.JumpFloodPass.Budget */
+	UPROPERTY(Config, EditAnywhere, meta = (ClampMin = "0", UIMin = "0", Units = "ms"))
+	float GPUBudget = 0.0f;
+
+	/**
+	 * Post process material run after tonemapping with the field bound as PostProcessInput3 and PostProcessInput4, when
+	 * r.JumpFloodPass.PostProcessInput is set. It is the only material that sees the field: materials in post process volumes
+	 * don't, and this one runs after tonemapping whatever its blendable location. Temporal reuse (r.JumpFloodPass.Temporal) is
+	 * off while the field is handed over this way, so every view floods in full each frame
+	 */
+	UPROPERTY(Config, EditAnywhere)
+	TSoftObjectPtr<UMaterialInterface> PostProcessMaterial;
+
+	/**
+	 * Optional. The render targets are sized in buckets that can be larger than the views, so their JumpFloodViewport vector is set to
+	 * the region the views resolve into, as (MinU, MinV, MaxU, MaxV), for materials mapping screen UV onto the render targets
+	 */
+	UPROPERTY(Config, EditAnywhere)
+	TSoftObjectPtr<UMaterialParameterCollection> ViewportParameterCollection;
+
 };
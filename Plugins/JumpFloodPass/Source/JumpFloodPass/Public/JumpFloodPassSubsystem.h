@@ -6,6 +6,32 @@
 #include "JumpFloodPassSubsystem.generated.h"
 
 class FJumpFloodPassSceneViewExtension;
+class USplineComponent;
+struct FJumpFloodSeedSource;
+
+/** Refers to a seed source registered with UJumpFloodPassSubsystem */
+USTRUCT(BlueprintType)
+struct JUMPFLOODPASS_API FJumpFloodSeedHandle
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	int32 Id = INDEX_NONE;
+
+	bool IsValid() const { return Id != INDEX_NONE; }
+};
+
+/** Refers to a field query registered with UJumpFloodPassSubsystem */
+USTRUCT(BlueprintType)
+struct JUMPFLOODPASS_API FJumpFloodFieldQueryHandle
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	int32 Id = INDEX_NONE;
+
+	bool IsValid() const { return Id != INDEX_NONE; }
+};
 
 UCLASS()
 class JUMPFLOODPASS_API UJumpFloodPassSubsystem final : public UWorldSubsystem
@@ -20,6 +46,77 @@ public:
 	virtual bool ShouldCreateSubsystem(UObject* Outer) const override final;
 	//~ End USubsystem Interface
 
+	/**
+	 * Seed sources are shapes seeded straight into the flood alongside, or instead of (r.JumpFloodPass.StencilSeeds), the edges of
+	 * custom stencil. Each reports StencilId in the field's stencil, and Radius is in output pixels.
+	 *
+	 * Each view splits its seed sources into pieces of up to 64x64 texels, and seeds no more than 65535 of them. Past that, the rest
+	 * of the sources are left out of the flood, counted in the Seed Pieces Dropped stat with a warning the first time.
+	 */
+
+	/** Seeds a disc around a world location */
+	UFUNCTION(BlueprintCallable, Category = "Jump Flood")
+	FJumpFloodSeedHandle AddPointSeed(const FVector& Location, int32 StencilId = 1, float Radius = 0.0f);
+
+	/** Seeds along a line between two world locations */
+	UFUNCTION(BlueprintCallable, Category = "Jump Flood")
+	FJumpFloodSeedHandle AddSegmentSeed(const FVector& Start, const FVector& End, int32 StencilId = 1, float Radius = 0.0f);
+
+	/** Seeds along the lines joining each world location to the next */
+	UFUNCTION(BlueprintCallable, Category = "Jump Flood")
+	FJumpFloodSeedHandle AddPolylineSeed(const TArray<FVector>& Points, int32 StencilId = 1, float Radius = 0.0f);
+
+	/** Seeds along a spline as it is now, sampled every SampleSpacing world units. Moving the spline needs the seed updating */
+	UFUNCTION(BlueprintCallable, Category = "Jump Flood")
+	FJumpFloodSeedHandle AddSplineSeed(const USplineComponent* Spline, int32 StencilId = 1, float Radius = 0.0f, float SampleSpacing = 50.0f);
+
+	/** Seeds a filled rectangle of every view, given in view UV */
+	UFUNCTION(BlueprintCallable, Category = "Jump Flood")
+	FJumpFloodSeedHandle AddScreenRectSeed(const FVector2D& Min, const FVector2D& Max, int32 StencilId = 1);
+
+	/** Moves a seed to new points, in the same form it was added with. Returns false if the seed no longer exists */
+	UFUNCTION(BlueprintCallable, Category = "Jump Flood")
+	bool UpdateSeedPoints(FJumpFloodSeedHandle Handle, const TArray<FVector>& Points);
+
+	UFUNCTION(BlueprintCallable, Category = "Jump Flood")
+	void RemoveSeed(FJumpFloodSeedHandle Handle);
+
+	UFUNCTION(BlueprintCallable, Category = "Jump Flood")
+	void ClearSeeds();
+
+	/**
+	 * Field queries read the distance field back at points of the view, given in view UV, without stalling the game or render
+	 * thread. Each is sampled once a frame and answered a few frames later, from the first view flooded that frame unless the
+	 * scene view extension's SetFieldQueryViewKey picks another.
+	 */
+
+	UFUNCTION(BlueprintCallable, Category = "Jump Flood")
+	FJumpFloodFieldQueryHandle AddFieldQuery(const FVector2D& ViewUV);
+
+	/** Moves a query to a new point. Answers for the old one keep arriving until the move reaches the GPU */
+	UFUNCTION(BlueprintCallable, Category = "Jump Flood")
+	bool UpdateFieldQuery(FJumpFloodFieldQueryHandle Handle, const FVector2D& ViewUV);
+
+	UFUNCTION(BlueprintCallable, Category = "Jump Flood")
+	void RemoveFieldQuery(FJumpFloodFieldQueryHandle Handle);
+
+	UFUNCTION(BlueprintCallable, Category = "Jump Flood")
+	void ClearFieldQueries();
+
+	/**
+	 * The latest answer to a query. Distance is in output pixels, negative inside the mask, and SeedUV is the nearest seed in view
+	 * UV. StencilId and Depth are those at the seed. Returns false until an answer has arrived, or when no seed was within reach
+	 */
+	UFUNCTION(BlueprintPure, Category = "Jump Flood")
+	bool GetFieldQueryResult(FJumpFloodFieldQueryHandle Handle, float& Distance, FVector2D& SeedUV, int32& StencilId, float& Depth, int32& FrameNumber) const;
+
+	/**
+	 * What the GPU budget (r.JumpFloodPass.Budget) last measured and decided, for profiling. CostMs is the smoothed GPU time of a
+	 * frame's floods, and RenderScaleFraction the fraction of r.JumpFloodPass.RenderScale they run at
+	 */
+	UFUNCTION(BlueprintPure, Category = "Jump Flood")
+	void GetBudgetState(float& CostMs, float& RenderScaleFraction, int32& FloodPassReduction, int32& RefinementPassCount) const;
+
 protected:
 
 	//~ Begin UWorldSubsystem Interface
@@ -28,6 +125,8 @@ protected:
 
 private:
 
+	FJumpFloodSeedHandle AddSeed(FJumpFloodSeedSource&& SeedSource);
+
 	TSharedPtr<FJumpFloodPassSceneViewExtension, ESPMode::ThreadSafe> SceneViewExtension;
 
 };
@@ -0,0 +1,28 @@
+// Copyright James Maiden. All Rights Reserved.
+
+using UnrealBuildTool;
+
+public class JumpFloodPassEditor : ModuleRules
+{
+	public JumpFloodPassEditor(ReadOnlyTargetRules Target) : base(Target)
+	{
+		PCHUsage = ModuleRules.PCHUsageMode.UseExplicitOrSharedPCHs;
+
+		PublicDependencyModuleNames.AddRange(
+			new string[]
+			{
+				"Core",
+			}
+			);
+
+		PrivateDependencyModuleNames.AddRange(
+			new string[]
+			{
+				"CoreUObject",
+				"Engine",
+				"ImageCore",
+				"JumpFloodPass",
+			}
+			);
+	}
+}
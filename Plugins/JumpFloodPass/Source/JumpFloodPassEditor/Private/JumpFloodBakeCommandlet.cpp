@@ -0,0 +1,175 @@
+// Copyright James Maiden. All Rights Reserved.
+#include "JumpFloodBakeCommandlet.h"
+#include "JumpFloodCPU.h"
+
+#include "Async/ParallelFor.h"
+#include "Engine/Texture2D.h"
+#include "HAL/PlatformTime.h"
+#include "ImageCore.h"
+#include "Misc/PackageName.h"
+#include "UObject/Package.h"
+#include "UObject/SavePackage.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogJumpFloodBake, Log, All);
+
+//  Source rows converted to linear at a time, so the conversion needs a band's worth of memory rather than the whole source's
+static constexpr int32 JumpFloodBakeBandRows = 64;
+
+UJumpFloodBakeCommandlet::UJumpFloodBakeCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+static bool ReadMask(UTexture2D* Texture, int32 Channel, float Threshold, FIntPoint& OutSize, TArray<uint8>& OutStencil)
+{
+	FImage SourceImage;
+	if (!Texture->Source.IsValid() || !Texture->Source.GetMipImage(SourceImage, 0, 0, 0))
+	{
+		return false;
+	}
+
+	OutSize = FIntPoint(SourceImage.SizeX, SourceImage.SizeY);
+	OutStencil.SetNumUninitialized(SourceImage.GetNumPixels());
+
+	const int64 BytesPerRow = SourceImage.GetBytesPerPixel() * SourceImage.SizeX;
+	const int32 BandCount = FMath::DivideAndRoundUp(SourceImage.SizeY, JumpFloodBakeBandRows);
+
+	ParallelFor(BandCount, [&SourceImage, &OutStencil, Channel, Threshold, BytesPerRow](int32 BandIndex)
+	{
+		const int32 RowBegin = BandIndex * JumpFloodBakeBandRows;
+		const int32 RowCount = FMath::Min(JumpFloodBakeBandRows, SourceImage.SizeY - RowBegin);
+
+		const FImageView SourceBand(SourceImage.RawData.GetData() + RowBegin * BytesPerRow, SourceImage.SizeX, RowCount, 1, SourceImage.Format, SourceImage.GammaSpace);
+
+		FImage LinearBand(SourceImage.SizeX, RowCount, ERawImageFormat::RGBA32F, EGammaSpace::Linear);
+		FImageCore::CopyImage(SourceBand, LinearBand);
+
+		const TArrayView64<FLinearColor> Colors = LinearBand.AsRGBA32F();
+		uint8* StencilBand = OutStencil.GetData() + (int64) RowBegin * SourceImage.SizeX;
+
+		for (int64 Index = 0; Index < Colors.Num(); ++Index)
+		{
+			StencilBand[Index] = Colors[Index].Component(Channel) >= Threshold ? 1 : 0;
+		}
+	});
+
+	return true;
+}
+
+static bool WriteField(const FString& DestPackageName, const FJumpFloodCPUField& Field)
+{
+	const FString AssetName = FPackageName::GetLongPackageAssetName(DestPackageName);
+
+	UPackage* Package = CreatePackage(*DestPackageName);
+	Package->FullyLoad();
+
+	//  Rebaking keeps the existing asset, so references to it survive
+	UTexture2D* Texture = FindObject<UTexture2D>(Package, *AssetName);
+	if (!Texture)
+	{
+		Texture = NewObject<UTexture2D>(Package, *AssetName, RF_Public | RF_Standalone);
+	}
+
+	Texture->PreEditChange(nullptr);
+	Texture->Source.Init(Field.Size.X, Field.Size.Y, 1, 1, TSF_RGBA32F, reinterpret_cast<const uint8*>(Field.Primary.GetData()));
+	Texture->SRGB = false;
+	Texture->CompressionSettings = TC_HDR_F32;
+	Texture->MipGenSettings = TMGS_NoMipmaps;
+	Texture->PostEditChange();
+
+	Package->MarkPackageDirty();
+
+	FSavePackageArgs SaveArgs;
+	SaveArgs.TopLevelFlags = RF_Public | RF_Standalone;
+
+	const FString Filename = FPackageName::LongPackageNameToFilename(DestPackageName, FPackageName::GetAssetPackageExtension());
+	return UPackage::SavePackage(Package, Texture, *Filename, SaveArgs);
+}
+
+int32 UJumpFloodBakeCommandlet::Main(const FString& Params)
+{
+	FString SourceList;
+	if (!FParse::Value(*Params, TEXT("Source="), SourceList))
+	{
+		UE_LOG(LogJumpFloodBake, Error, TEXT("Usage: -run=JumpFloodBake -Source=/Game/Path/T_Mask[+/Game/Path/T_Other] [-Dest=/Game/Path/T_Mask_SDF] [-Method=JFA|EDT] [-MaxDistance=0] [-Threshold=0.5] [-Channel=R|G|B|A]"));
+		return 1;
+	}
+
+	TArray<FString> SourcePackageNames;
+	SourceList.ParseIntoArray(SourcePackageNames, TEXT("+"));
+
+	FString DestPackageName;
+	FParse::Value(*Params, TEXT("Dest="), DestPackageName);
+	if (!DestPackageName.IsEmpty() && SourcePackageNames.Num() > 1)
+	{
+		UE_LOG(LogJumpFloodBake, Error, TEXT("-Dest can only be given with a single -Source"));
+		return 1;
+	}
+
+	FJumpFloodCPUSettings Settings;
+
+	FString Method;
+	FParse::Value(*Params, TEXT("Method="), Method);
+	Settings.Method = Method == TEXT("EDT") ? EJumpFloodCPUMethod::ExactEDT : EJumpFloodCPUMethod::JumpFlood;
+
+	FParse::Value(*Params, TEXT("MaxDistance="), Settings.MaxDistance);
+
+	//  Only Primary is written out
+	Settings.bResolveSecondary = false;
+
+	float Threshold = 0.5f;
+	FParse::Value(*Params, TEXT("Threshold="), Threshold);
+
+	FString ChannelName = TEXT("A");
+	FParse::Value(*Params, TEXT("Channel="), ChannelName);
+
+	const int32 Channel = FString(TEXT("RGBA")).Find(ChannelName.Left(1), ESearchCase::IgnoreCase);
+	if (ChannelName.Len() != 1 || Channel == INDEX_NONE)
+	{
+		UE_LOG(LogJumpFloodBake, Error, TEXT("-Channel must be one of R, G, B or A"));
+		return 1;
+	}
+
+	int32 FailureCount = 0;
+	for (const FString& SourcePackageName : SourcePackageNames)
+	{
+		const FString SourceObjectPath = SourcePackageName + TEXT(".") + FPackageName::GetLongPackageAssetName(SourcePackageName);
+
+		UTexture2D* SourceTexture = LoadObject<UTexture2D>(nullptr, *SourceObjectPath);
+		FIntPoint Size;
+		TArray<uint8> Stencil;
+
+		if (!SourceTexture || !ReadMask(SourceTexture, Channel, Threshold, Size, Stencil))
+		{
+			UE_LOG(LogJumpFloodBake, Error, TEXT("Could not read a mask from %s"), *SourcePackageName);
+			++FailureCount;
+			continue;
+		}
+
+		if (Size.X > FJumpFloodCPU::MaxSize || Size.Y > FJumpFloodCPU::MaxSize)
+		{
+			UE_LOG(LogJumpFloodBake, Error, TEXT("%s is %dx%d, larger than the %d texels a side that can be flooded"), *SourcePackageName, Size.X, Size.Y, FJumpFloodCPU::MaxSize);
+			++FailureCount;
+			continue;
+		}
+
+		const double StartTime = FPlatformTime::Seconds();
+		const FJumpFloodCPUField Field = FJumpFloodCPU::Compute(Size, Stencil, Settings);
+		const double FloodTime = FPlatformTime::Seconds() - StartTime;
+
+		const FString OutputPackageName = DestPackageName.IsEmpty() ? SourcePackageName + TEXT("_SDF") : DestPackageName;
+		if (!WriteField(OutputPackageName, Field))
+		{
+			UE_LOG(LogJumpFloodBake, Error, TEXT("Could not save %s"), *OutputPackageName);
+			++FailureCount;
+			continue;
+		}
+
+		UE_LOG(LogJumpFloodBake, Display, TEXT("Baked %s (%dx%d) into %s in %.1f ms"), *SourcePackageName, Size.X, Size.Y, *OutputPackageName, FloodTime * 1000.0);
+	}
+
+	return FailureCount > 0 ? 1 : 0;
+}
@@ -0,0 +1,5 @@
+// Copyright James Maiden. All Rights Reserved.
+
+#include "Modules/ModuleManager.h"
+
+IMPLEMENT_MODULE(FDefaultModuleImpl, JumpFloodPassEditor)
@@ -0,0 +1,28 @@
+// Copyright James Maiden. All Rights Reserved.
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "JumpFloodBakeCommandlet.generated.h"
+
+/**
+ * Bakes texture masks into distance field textures with the CPU jump flood, in the same layout as the Primary render target.
+ * Lives in the editor module because it reads texture source data, which only editor builds keep.
+ *
+ * -run=JumpFloodBake -Source=/Game/Path/T_Mask[+/Game/Path/T_Other] [-Dest=/Game/Path/T_Mask_SDF] [-Method=JFA|EDT]
+ *     [-MaxDistance=0] [-Threshold=0.5] [-Channel=R|G|B|A]
+ */
+UCLASS()
+class JUMPFLOODPASSEDITOR_API UJumpFloodBakeCommandlet final : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+
+	UJumpFloodBakeCommandlet();
+
+	//~ Begin UCommandlet Interface
+	virtual int32 Main(const FString& Params) override final;
+	//~ End UCommandlet Interface
+
+};